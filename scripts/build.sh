@@ -36,6 +36,12 @@ mkdir -p build dist/hush1
   src/dsp/sh101_env.c \
   src/dsp/sh101_filter.c \
   src/dsp/sh101_lfo.c \
+  src/dsp/sh101_adaa.c \
+  src/dsp/sh101_oversample.c \
+  src/dsp/sh101_noise.c \
+  src/dsp/sh101_cpu.c \
+  src/dsp/sh101_poly.c \
+  src/dsp/sh101_quality.c \
   -o build/dsp.so \
   -Isrc \
   -Isrc/dsp \
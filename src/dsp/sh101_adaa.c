@@ -0,0 +1,43 @@
+#include "sh101_adaa.h"
+
+#include <math.h>
+
+float sh101_adaa_logcosh_table[SH101_ADAA_TABLE_SIZE + 1][4];
+static int g_table_ready;
+
+/* R(a) and R'(a) = tanh(a) - 1 in double. */
+static double rem_d(double a) {
+    return log1p(exp(-2.0 * a)) - log(2.0);
+}
+
+static double rem_slope_d(double a) {
+    return tanh(a) - 1.0;
+}
+
+void sh101_adaa_init(void) {
+    const double h = (double)SH101_ADAA_TABLE_MAX / (double)SH101_ADAA_TABLE_SIZE;
+    if (g_table_ready) return;
+    for (int i = 0; i < SH101_ADAA_TABLE_SIZE; ++i) {
+        double p0 = rem_d(h * i);
+        double p1 = rem_d(h * (i + 1));
+        double m0 = rem_slope_d(h * i) * h;
+        double m1 = rem_slope_d(h * (i + 1)) * h;
+        sh101_adaa_logcosh_table[i][0] = (float)p0;
+        sh101_adaa_logcosh_table[i][1] = (float)m0;
+        sh101_adaa_logcosh_table[i][2] = (float)(3.0 * (p1 - p0) - 2.0 * m0 - m1);
+        sh101_adaa_logcosh_table[i][3] = (float)(2.0 * (p0 - p1) + m0 + m1);
+    }
+    sh101_adaa_logcosh_table[SH101_ADAA_TABLE_SIZE][0] = (float)rem_d(SH101_ADAA_TABLE_MAX);
+    sh101_adaa_logcosh_table[SH101_ADAA_TABLE_SIZE][1] = 0.0f;
+    sh101_adaa_logcosh_table[SH101_ADAA_TABLE_SIZE][2] = 0.0f;
+    sh101_adaa_logcosh_table[SH101_ADAA_TABLE_SIZE][3] = 0.0f;
+    g_table_ready = 1;
+}
+
+void sh101_adaa_tanh_block(float *prev, const float *in, float *out, float gain, int n) {
+    float u0 = *prev;
+    for (int i = 0; i < n; ++i) {
+        out[i] = sh101_adaa_tanh(&u0, gain * in[i]);
+    }
+    *prev = u0;
+}
@@ -0,0 +1,106 @@
+#ifndef SH101_ADAA_H
+#define SH101_ADAA_H
+
+/* First-order antiderivative anti-aliasing (ADAA) for the saturators.
+
+   A memoryless f(x) is replaced by the mean of f over the segment between
+   consecutive inputs, (F(x[n]) - F(x[n-1])) / (x[n] - x[n-1]), with F the
+   antiderivative of f.  This suppresses most of the aliasing the
+   nonlinearity generates, at the price of half a sample of delay and a
+   gentle high-frequency rolloff (-2.4 dB at 10 kHz, 44.1 kHz).
+
+   tanh: F(u) = log(cosh(u)) = |u| + R(|u|) where
+   R(a) = log(1 + exp(-2a)) - log(2) is read from a cubic Hermite table.
+   Nearby inputs are differenced inside one table segment, so the quotient
+   stays accurate down to SH101_ADAA_EPS; closer inputs fall back to tanh at
+   the midpoint.
+
+   Cubic x - c*x^3: the quotient has a closed form with no division. */
+
+#include "sh101_fastmath.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SH101_ADAA_TABLE_SIZE 512
+#define SH101_ADAA_TABLE_MAX 8.0f
+#define SH101_ADAA_EPS 1.0e-5f
+
+/* Per-segment cubic coefficients of R over [i, i+1] * MAX / SIZE; the last
+   row holds the constant tail. */
+extern float sh101_adaa_logcosh_table[SH101_ADAA_TABLE_SIZE + 1][4];
+
+/* Builds the table; cheap to call again. */
+void sh101_adaa_init(void);
+
+#define SH101_ADAA_TABLE_SCALE ((float)SH101_ADAA_TABLE_SIZE / SH101_ADAA_TABLE_MAX)
+
+/* R(a) = log(cosh(a)) - a for a >= 0. */
+static inline float sh101_adaa_logcosh_rem(float a) {
+    float x = a * SH101_ADAA_TABLE_SCALE;
+    int i;
+    float t;
+    const float *c;
+    if (x >= (float)SH101_ADAA_TABLE_SIZE) {
+        i = SH101_ADAA_TABLE_SIZE;
+        t = 0.0f;
+    } else {
+        i = (int)x;
+        t = x - (float)i;
+    }
+    c = sh101_adaa_logcosh_table[i];
+    return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+}
+
+/* R(a1) - R(a0).  Inputs less than a segment apart share one cubic, so the
+   constant term cancels exactly and the difference factors through
+   (t1 - t0), which is exact because the table scale is a power of two. */
+static inline float sh101_adaa_logcosh_rem_diff(float a0, float a1) {
+    float x0 = a0 * SH101_ADAA_TABLE_SCALE;
+    float x1 = a1 * SH101_ADAA_TABLE_SCALE;
+    float lo = x0 < x1 ? x0 : x1;
+    if (x1 - x0 < 1.0f && x0 - x1 < 1.0f) {
+        int i;
+        float t0, t1;
+        const float *c;
+        if (lo >= (float)SH101_ADAA_TABLE_SIZE) return 0.0f;
+        i = (int)lo;
+        c = sh101_adaa_logcosh_table[i];
+        t0 = x0 - (float)i;
+        t1 = x1 - (float)i;
+        return (t1 - t0) * (c[1] + c[2] * (t1 + t0) + c[3] * (t1 * t1 + t1 * t0 + t0 * t0));
+    }
+    return sh101_adaa_logcosh_rem(a1) - sh101_adaa_logcosh_rem(a0);
+}
+
+/* ADAA tanh(u); `prev` holds the previous u and is updated. */
+static inline float sh101_adaa_tanh(float *prev, float u) {
+    float u0 = *prev;
+    float d = u - u0;
+    float a0, a1;
+    *prev = u;
+    if (d > -SH101_ADAA_EPS && d < SH101_ADAA_EPS) {
+        return sh101_fast_tanhf(0.5f * (u + u0));
+    }
+    a0 = u0 < 0.0f ? -u0 : u0;
+    a1 = u < 0.0f ? -u : u;
+    return ((a1 - a0) + sh101_adaa_logcosh_rem_diff(a0, a1)) / d;
+}
+
+/* ADAA x - c*x^3; `prev` holds the previous x and is updated. */
+static inline float sh101_adaa_cubic(float *prev, float x, float c) {
+    float x0 = *prev;
+    float s = x + x0;
+    *prev = x;
+    return 0.5f * s - 0.25f * c * s * (x * x + x0 * x0);
+}
+
+/* out[i] = ADAA tanh(gain * in[i]); in and out may alias. */
+void sh101_adaa_tanh_block(float *prev, const float *in, float *out, float gain, int n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,6 +1,7 @@
 #include "sh101_control.h"
 
-#include <math.h>
+#include "sh101_fastmath.h"
+
 #include <string.h>
 
 static int clamp_int(int v, int lo, int hi) {
@@ -9,19 +10,39 @@ static int clamp_int(int v, int lo, int hi) {
     return v;
 }
 
+float sh101_pitch_st_to_hz(float st) {
+    return 440.0f * sh101_fast_exp2f((st - 69.0f) * (1.0f / 12.0f));
+}
+
 float sh101_midi_note_to_hz(int note) {
-    return 440.0f * powf(2.0f, ((float)note - 69.0f) / 12.0f);
+    return sh101_pitch_st_to_hz((float)note);
 }
 
-static void recalc_glide_alpha(sh101_control_t *ctrl) {
+static void recalc_glide_coefs(sh101_control_t *ctrl) {
+    ctrl->glide_coef_ms = ctrl->glide_ms;
+    ctrl->glide_coef_sr = ctrl->sample_rate;
+    ctrl->glide_coef_linear = ctrl->glide_linear;
+    ctrl->glide_keep_frames = 0;
     if (ctrl->glide_ms <= 0.01f) {
         ctrl->glide_alpha = 1.0f;
+        ctrl->glide_inv_tau = 1.0f;
         return;
     }
     float t = ctrl->glide_ms * 0.001f;
     float tau = t * ctrl->sample_rate;
     if (tau < 1.0f) tau = 1.0f;
-    ctrl->glide_alpha = 1.0f - expf(-1.0f / tau);
+    ctrl->glide_inv_tau = 1.0f / tau;
+    ctrl->glide_alpha = 1.0f - sh101_fast_expf(-ctrl->glide_inv_tau);
+}
+
+/* Glide coefficients only depend on glide_ms, glide_linear and the sample
+   rate, so they are recomputed when one of those changes, not per sample. */
+static inline void refresh_glide_coefs(sh101_control_t *ctrl) {
+    if (ctrl->glide_coef_ms != ctrl->glide_ms ||
+        ctrl->glide_coef_sr != ctrl->sample_rate ||
+        ctrl->glide_coef_linear != ctrl->glide_linear) {
+        recalc_glide_coefs(ctrl);
+    }
 }
 
 static void remove_from_order(sh101_control_t *ctrl, int note) {
@@ -63,19 +84,20 @@ static void update_target_note(sh101_control_t *ctrl, int new_note) {
     ctrl->current_note = new_note;
     if (new_note < 0) {
         ctrl->gate = ctrl->hold_enabled ? ctrl->gate : 0;
-        ctrl->glide_step_hz = 0.0f;
+        ctrl->glide_step_st = 0.0f;
         return;
     }
 
     int effective_note = clamp_int(new_note + ctrl->transpose, 0, 127);
+    ctrl->pitch_target_st = (float)effective_note;
     ctrl->pitch_target_hz = sh101_midi_note_to_hz(effective_note);
     if ((!ctrl->gate && !ctrl->glide_always) || ctrl->glide_ms <= 0.01f) {
+        ctrl->pitch_current_st = ctrl->pitch_target_st;
         ctrl->pitch_current_hz = ctrl->pitch_target_hz;
-        ctrl->glide_step_hz = 0.0f;
+        ctrl->glide_step_st = 0.0f;
     } else if (ctrl->glide_linear) {
-        float tau = ctrl->glide_ms * 0.001f * ctrl->sample_rate;
-        if (tau < 1.0f) tau = 1.0f;
-        ctrl->glide_step_hz = (ctrl->pitch_target_hz - ctrl->pitch_current_hz) / tau;
+        refresh_glide_coefs(ctrl);
+        ctrl->glide_step_st = (ctrl->pitch_target_st - ctrl->pitch_current_st) * ctrl->glide_inv_tau;
     }
     ctrl->gate = 1;
 }
@@ -84,14 +106,16 @@ void sh101_control_init(sh101_control_t *ctrl, float sample_rate) {
     memset(ctrl, 0, sizeof(*ctrl));
     ctrl->sample_rate = sample_rate;
     ctrl->current_note = -1;
+    ctrl->pitch_current_st = 60.0f;
+    ctrl->pitch_target_st = 60.0f;
     ctrl->pitch_current_hz = sh101_midi_note_to_hz(60);
     ctrl->pitch_target_hz = ctrl->pitch_current_hz;
     ctrl->priority = SH101_NOTE_PRIORITY_LAST;
     ctrl->glide_ms = 0.0f;
     ctrl->glide_always = 0;
     ctrl->glide_linear = 0;
-    ctrl->glide_step_hz = 0.0f;
-    recalc_glide_alpha(ctrl);
+    ctrl->glide_step_st = 0.0f;
+    recalc_glide_coefs(ctrl);
 }
 
 void sh101_control_set_priority(sh101_control_t *ctrl, sh101_note_priority_t priority) {
@@ -114,13 +138,18 @@ void sh101_control_set_transpose(sh101_control_t *ctrl, int semitones) {
     }
 }
 
+void sh101_control_set_glide(sh101_control_t *ctrl, float glide_ms, int linear) {
+    ctrl->glide_ms = glide_ms;
+    ctrl->glide_linear = linear ? 1 : 0;
+    refresh_glide_coefs(ctrl);
+}
+
 void sh101_control_note_on(sh101_control_t *ctrl, int note, int velocity) {
     (void)velocity;
     if (note < 0 || note > 127) return;
 
     ctrl->held[note] = 1;
     push_order(ctrl, note);
-    recalc_glide_alpha(ctrl);
     update_target_note(ctrl, pick_note(ctrl));
 }
 
@@ -150,20 +179,74 @@ void sh101_control_all_notes_off(sh101_control_t *ctrl) {
     }
 }
 
+static inline float linear_glide_step(float st, float step, float target) {
+    float next = st + step;
+    if ((step >= 0.0f && next >= target) || (step < 0.0f && next <= target)) {
+        return target;
+    }
+    return next;
+}
+
+static int glide_is_linear(const sh101_control_t *ctrl) {
+    return ctrl->glide_linear && ctrl->glide_ms > 0.01f;
+}
+
 void sh101_control_tick_pitch(sh101_control_t *ctrl) {
-    recalc_glide_alpha(ctrl);
-    if (ctrl->glide_linear && ctrl->glide_ms > 0.01f) {
-        float next = ctrl->pitch_current_hz + ctrl->glide_step_hz;
-        if ((ctrl->glide_step_hz >= 0.0f && next >= ctrl->pitch_target_hz) ||
-            (ctrl->glide_step_hz < 0.0f && next <= ctrl->pitch_target_hz)) {
-            ctrl->pitch_current_hz = ctrl->pitch_target_hz;
-        } else {
-            ctrl->pitch_current_hz = next;
+    refresh_glide_coefs(ctrl);
+    if (glide_is_linear(ctrl)) {
+        ctrl->pitch_current_st = linear_glide_step(ctrl->pitch_current_st, ctrl->glide_step_st,
+                                                   ctrl->pitch_target_st);
+    } else {
+        ctrl->pitch_current_st += (ctrl->pitch_target_st - ctrl->pitch_current_st) * ctrl->glide_alpha;
+    }
+    ctrl->pitch_current_hz = sh101_pitch_st_to_hz(ctrl->pitch_current_st);
+}
+
+void sh101_control_render_pitch_block(sh101_control_t *ctrl, float *out_hz, int frames) {
+    if (frames <= 0) return;
+    refresh_glide_coefs(ctrl);
+
+    /* One pass over the block in exp2 exponent units, then a vector exp2. */
+    float st = ctrl->pitch_current_st;
+    float target = ctrl->pitch_target_st;
+    if (glide_is_linear(ctrl)) {
+        float step = ctrl->glide_step_st;
+        for (int i = 0; i < frames; ++i) {
+            st = linear_glide_step(st, step, target);
+            out_hz[i] = (st - 69.0f) * (1.0f / 12.0f);
+        }
+    } else {
+        float alpha = ctrl->glide_alpha;
+        for (int i = 0; i < frames; ++i) {
+            st += (target - st) * alpha;
+            out_hz[i] = (st - 69.0f) * (1.0f / 12.0f);
         }
-        return;
     }
-    {
-        float d = ctrl->pitch_target_hz - ctrl->pitch_current_hz;
-        ctrl->pitch_current_hz += d * ctrl->glide_alpha;
+    ctrl->pitch_current_st = st;
+
+    sh101_fast_exp2f_block(out_hz, out_hz, frames);
+    for (int i = 0; i < frames; ++i) {
+        out_hz[i] *= 440.0f;
+    }
+    ctrl->pitch_current_hz = out_hz[frames - 1];
+}
+
+float sh101_control_advance_pitch(sh101_control_t *ctrl, int frames) {
+    if (frames <= 0) return ctrl->pitch_current_st;
+    refresh_glide_coefs(ctrl);
+    if (glide_is_linear(ctrl)) {
+        ctrl->pitch_current_st = linear_glide_step(ctrl->pitch_current_st,
+                                                   ctrl->glide_step_st * (float)frames,
+                                                   ctrl->pitch_target_st);
+    } else if (ctrl->glide_alpha >= 1.0f) {
+        ctrl->pitch_current_st = ctrl->pitch_target_st;
+    } else {
+        if (ctrl->glide_keep_frames != frames) {
+            ctrl->glide_keep = sh101_fast_powf(1.0f - ctrl->glide_alpha, (float)frames);
+            ctrl->glide_keep_frames = frames;
+        }
+        ctrl->pitch_current_st = ctrl->pitch_target_st -
+                                 (ctrl->pitch_target_st - ctrl->pitch_current_st) * ctrl->glide_keep;
     }
+    return ctrl->pitch_current_st;
 }
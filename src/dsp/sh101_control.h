@@ -26,7 +26,21 @@ typedef struct {
     int glide_always;
     int glide_linear;
     float glide_alpha;
-    float glide_step_hz;
+    float glide_inv_tau;
+    /* Inputs the glide coefficients were derived from; a mismatch with the
+       live fields triggers a recompute, so direct writes stay supported. */
+    float glide_coef_ms;
+    float glide_coef_sr;
+    int glide_coef_linear;
+    /* (1 - glide_alpha)^glide_keep_frames for closed-form tick advance. */
+    int glide_keep_frames;
+    float glide_keep;
+    /* Glide runs in semitones (MIDI note units) so it is linear in pitch. */
+    float glide_step_st;
+    float pitch_current_st;
+    float pitch_target_st;
+    /* Hz mirrors of the pitch state, refreshed on note events and by the
+       Hz-domain tick/block APIs (not by sh101_control_advance_pitch). */
     float pitch_current_hz;
     float pitch_target_hz;
 
@@ -37,12 +51,20 @@ void sh101_control_init(sh101_control_t *ctrl, float sample_rate);
 void sh101_control_set_priority(sh101_control_t *ctrl, sh101_note_priority_t priority);
 void sh101_control_set_hold(sh101_control_t *ctrl, int hold_enabled);
 void sh101_control_set_transpose(sh101_control_t *ctrl, int semitones);
+void sh101_control_set_glide(sh101_control_t *ctrl, float glide_ms, int linear);
 void sh101_control_note_on(sh101_control_t *ctrl, int note, int velocity);
 void sh101_control_note_off(sh101_control_t *ctrl, int note);
 void sh101_control_all_notes_off(sh101_control_t *ctrl);
 void sh101_control_tick_pitch(sh101_control_t *ctrl);
+/* Advances glide by `frames` samples, writing the pitch in Hz for each one. */
+void sh101_control_render_pitch_block(sh101_control_t *ctrl, float *out_hz, int frames);
+/* Advances glide by `frames` samples in closed form and returns the pitch in
+   semitones; the caller converts to Hz once, after adding modulation. */
+float sh101_control_advance_pitch(sh101_control_t *ctrl, int frames);
 
 float sh101_midi_note_to_hz(int note);
+/* Fractional MIDI note (semitones) to Hz. */
+float sh101_pitch_st_to_hz(float st);
 
 #ifdef __cplusplus
 }
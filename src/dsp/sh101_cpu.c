@@ -0,0 +1,85 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include "sh101_cpu.h"
+
+#include <time.h>
+
+#include "sh101_fastmath.h"
+
+int sh101_cpu_supports(sh101_isa_t isa) {
+    switch (isa) {
+    case SH101_ISA_SCALAR:
+        return 1;
+#if defined(SH101_FASTMATH_NEON)
+    case SH101_ISA_NEON:
+        return 1;
+#endif
+#if defined(SH101_FASTMATH_SSE2)
+    case SH101_ISA_SSE2:
+        return 1;
+#endif
+#if defined(SH101_CPU_X86_DISPATCH) && defined(SH101_FASTMATH_SSE2)
+    case SH101_ISA_AVX2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? 1 : 0;
+#endif
+    default:
+        return 0;
+    }
+}
+
+sh101_isa_t sh101_cpu_detect(void) {
+    static const sh101_isa_t order[] = {
+        SH101_ISA_AVX2, SH101_ISA_SSE2, SH101_ISA_NEON
+    };
+    for (unsigned i = 0; i < sizeof(order) / sizeof(order[0]); ++i) {
+        if (sh101_cpu_supports(order[i])) return order[i];
+    }
+    return SH101_ISA_SCALAR;
+}
+
+#if defined(SH101_FASTMATH_SSE2)
+#define CPU_MXCSR_FTZ_DAZ 0x8040u
+#elif defined(__aarch64__) && defined(__GNUC__)
+#define CPU_FPCR_FZ (1ull << 24)
+#endif
+
+uint64_t sh101_cpu_ftz_enter(void) {
+#if defined(CPU_MXCSR_FTZ_DAZ)
+    unsigned int csr = _mm_getcsr();
+    _mm_setcsr(csr | CPU_MXCSR_FTZ_DAZ);
+    return csr;
+#elif defined(CPU_FPCR_FZ)
+    uint64_t fpcr;
+    __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+    __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr | CPU_FPCR_FZ));
+    return fpcr;
+#else
+    return 0;
+#endif
+}
+
+void sh101_cpu_ftz_leave(uint64_t saved) {
+#if defined(CPU_MXCSR_FTZ_DAZ)
+    _mm_setcsr((unsigned int)saved);
+#elif defined(CPU_FPCR_FZ)
+    __asm__ __volatile__("msr fpcr, %0" : : "r"(saved));
+#else
+    (void)saved;
+#endif
+}
+
+const char *sh101_isa_name(sh101_isa_t isa) {
+    switch (isa) {
+    case SH101_ISA_SSE2: return "sse2";
+    case SH101_ISA_AVX2: return "avx2";
+    case SH101_ISA_NEON: return "neon";
+    default: return "scalar";
+    }
+}
+
+uint64_t sh101_cpu_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
@@ -0,0 +1,49 @@
+#ifndef SH101_CPU_H
+#define SH101_CPU_H
+
+/* Instruction-set levels the DSP kernels are built for.
+
+   The library is one binary for both the aarch64 Move and x86 hosts.
+   Baseline code targets NEON on aarch64 and SSE2 on x86-64.  Kernels that
+   gain from wider vectors are also compiled for AVX2 through per-function
+   target attributes.  They are selected at runtime, once, when the plugin
+   is initialised. */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    SH101_ISA_SCALAR = 0,
+    SH101_ISA_SSE2 = 1,
+    SH101_ISA_AVX2 = 2,
+    SH101_ISA_NEON = 3
+} sh101_isa_t;
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define SH101_CPU_X86_DISPATCH 1
+#endif
+
+/* Best level this build and the running CPU both support. */
+sh101_isa_t sh101_cpu_detect(void);
+/* Whether `isa` can run here (scalar always can). */
+int sh101_cpu_supports(sh101_isa_t isa);
+/* "scalar", "sse2", "avx2" or "neon". */
+const char *sh101_isa_name(sh101_isa_t isa);
+
+/* Turns on flush-to-zero for the calling thread: FTZ and DAZ in MXCSR on
+   x86, FPCR.FZ on aarch64.  Returns the previous mode for
+   sh101_cpu_ftz_leave.  No-op elsewhere. */
+uint64_t sh101_cpu_ftz_enter(void);
+void sh101_cpu_ftz_leave(uint64_t saved);
+
+/* Monotonic clock in nanoseconds, for timing render calls. */
+uint64_t sh101_cpu_now_ns(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
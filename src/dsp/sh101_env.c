@@ -1,11 +1,26 @@
 #include "sh101_env.h"
 
+#include <math.h>
+
+#include "sh101_fastmath.h"
+
 static float clampf(float v, float lo, float hi) {
     if (v < lo) return lo;
     if (v > hi) return hi;
     return v;
 }
 
+static void stage_coefs(float time_s, float sample_rate, float scale, float *k, float *lr) {
+    *k = scale / (time_s * sample_rate);
+    *lr = (float)(log1p(-(double)clampf(*k, 0.0f, 0.999f)) / log(2.0));
+}
+
+static void recalc_coefs(sh101_env_t *env) {
+    stage_coefs(env->attack_s, env->sample_rate, 1.8f, &env->attack_k, &env->attack_lr);
+    stage_coefs(env->decay_s, env->sample_rate, 2.0f, &env->decay_k, &env->decay_lr);
+    stage_coefs(env->release_s, env->sample_rate, 2.0f, &env->release_k, &env->release_lr);
+}
+
 void sh101_env_init(sh101_env_t *env, float sample_rate) {
     env->sample_rate = sample_rate;
     env->attack_s = 0.01f;
@@ -17,6 +32,7 @@ void sh101_env_init(sh101_env_t *env, float sample_rate) {
     env->release_start = 0.0f;
     env->velocity = 1.0f;
     env->stage = ENV_IDLE;
+    recalc_coefs(env);
 }
 
 void sh101_env_set_adsr(sh101_env_t *env, float attack_s, float decay_s, float sustain, float release_s) {
@@ -24,6 +40,7 @@ void sh101_env_set_adsr(sh101_env_t *env, float attack_s, float decay_s, float s
     env->decay_s = clampf(decay_s, 0.0005f, 10.0f);
     env->sustain = clampf(sustain, 0.0f, 1.0f);
     env->release_s = clampf(release_s, 0.0005f, 10.0f);
+    recalc_coefs(env);
 }
 
 void sh101_env_gate_on(sh101_env_t *env, float velocity) {
@@ -39,13 +56,11 @@ void sh101_env_gate_off(sh101_env_t *env) {
 
 float sh101_env_process(sh101_env_t *env) {
     float target = 0.0f;
-    float coeff = 1.0f;
 
     switch (env->stage) {
         case ENV_ATTACK:
             target = env->velocity;
-            coeff = 1.0f / (env->attack_s * env->sample_rate);
-            env->value += (target - env->value) * coeff * 1.8f;
+            env->value += (target - env->value) * env->attack_k;
             if (env->value >= target - 0.001f) {
                 env->value = target;
                 env->stage = ENV_DECAY;
@@ -54,8 +69,7 @@ float sh101_env_process(sh101_env_t *env) {
 
         case ENV_DECAY:
             target = env->sustain * env->velocity;
-            coeff = 1.0f / (env->decay_s * env->sample_rate);
-            env->value += (target - env->value) * coeff * 2.0f;
+            env->value += (target - env->value) * env->decay_k;
             if (env->value <= target + 0.001f) {
                 env->value = target;
                 env->stage = ENV_SUSTAIN;
@@ -67,9 +81,7 @@ float sh101_env_process(sh101_env_t *env) {
             break;
 
         case ENV_RELEASE:
-            target = 0.0f;
-            coeff = 1.0f / (env->release_s * env->sample_rate);
-            env->value += (target - env->value) * coeff * 2.0f;
+            env->value -= env->value * env->release_k;
             if (env->value <= 0.0001f) {
                 env->value = 0.0f;
                 env->stage = ENV_IDLE;
@@ -85,3 +97,170 @@ float sh101_env_process(sh101_env_t *env) {
     env->value = clampf(env->value, 0.0f, 1.0f);
     return env->value;
 }
+
+/* Samples until an exponential segment with per-sample log2 ratio `lr`
+   brings `dist` down to `done_dist` (at least 1). */
+static int segment_steps(float dist, float lr, float done_dist) {
+    if (dist <= done_dist) return 1;
+    float m = ceilf((sh101_fast_log2f(done_dist) - sh101_fast_log2f(dist)) / lr);
+    if (m < 1.0f) return 1;
+    if (m > 1.0e9f) return 1000000000;
+    return (int)m;
+}
+
+/* Float rounding in the recurrence can shift the real transition by a few
+   percent of a long segment, so the unchecked run stops short of it. */
+static int unchecked_run(int steps, int frames) {
+    int run = steps - (steps >> 4) - 2;
+    if (run > frames) run = frames;
+    return run > 0 ? run : 0;
+}
+
+void sh101_env_process_block(sh101_env_t *env, float *out, int frames) {
+    int i = 0;
+    while (i < frames) {
+        float v = env->value;
+        float target;
+        int run;
+
+        switch (env->stage) {
+            case ENV_ATTACK: {
+                float k = env->attack_k;
+                target = env->velocity;
+                run = unchecked_run(segment_steps(target - v, env->attack_lr, 0.001f), frames - i);
+                for (int j = 0; j < run; ++j) {
+                    v += (target - v) * k;
+                    out[i + j] = v;
+                }
+                env->value = v;
+                i += run;
+                break;
+            }
+
+            case ENV_DECAY: {
+                float k = env->decay_k;
+                target = env->sustain * env->velocity;
+                run = unchecked_run(segment_steps(v - target, env->decay_lr, 0.001f), frames - i);
+                for (int j = 0; j < run; ++j) {
+                    v += (target - v) * k;
+                    out[i + j] = v;
+                }
+                env->value = v;
+                i += run;
+                break;
+            }
+
+            case ENV_RELEASE: {
+                float k = env->release_k;
+                run = unchecked_run(segment_steps(v, env->release_lr, 0.0001f), frames - i);
+                for (int j = 0; j < run; ++j) {
+                    v -= v * k;
+                    out[i + j] = v;
+                }
+                env->value = v;
+                i += run;
+                break;
+            }
+
+            case ENV_SUSTAIN:
+            case ENV_IDLE:
+            default: {
+                float fill = sh101_env_process(env);
+                for (; i < frames; ++i) out[i] = fill;
+                return;
+            }
+        }
+
+        /* Step up to and through the stage transition one sample at a time. */
+        {
+            sh101_env_stage_t stage = env->stage;
+            while (i < frames && env->stage == stage) {
+                out[i++] = sh101_env_process(env);
+            }
+        }
+    }
+}
+
+/* Runs one exponential segment for up to `frames` samples.  The per-sample
+   update d *= (1 - k) is applied in closed form; returns the number of samples
+   consumed, or 0 if the segment reached `done_dist` and must end there. */
+static int advance_segment(float *dist, float lr, float done_dist, int frames, int *steps_to_end) {
+    int m = segment_steps(*dist, lr, done_dist);
+    if (m <= frames) {
+        *steps_to_end = m;
+        return 0;
+    }
+    *dist *= sh101_fast_exp2f((float)frames * lr);
+    return frames;
+}
+float sh101_env_advance_state(const sh101_env_t *env, float *value, sh101_env_stage_t *stage,
+                              float velocity, int frames) {
+    float v = *value;
+    sh101_env_stage_t st = *stage;
+
+    while (frames > 0) {
+        float target;
+        float dist;
+        int steps = 0;
+
+        switch (st) {
+            case ENV_ATTACK:
+                target = velocity;
+                dist = target - v;
+                if (advance_segment(&dist, env->attack_lr, 0.001f, frames, &steps)) {
+                    v = target - dist;
+                    frames = 0;
+                } else {
+                    v = target;
+                    st = ENV_DECAY;
+                    frames -= steps;
+                }
+                break;
+
+            case ENV_DECAY:
+                target = env->sustain * velocity;
+                dist = v - target;
+                if (advance_segment(&dist, env->decay_lr, 0.001f, frames, &steps)) {
+                    v = target + dist;
+                    frames = 0;
+                } else {
+                    v = target;
+                    st = ENV_SUSTAIN;
+                    frames -= steps;
+                }
+                break;
+
+            case ENV_SUSTAIN:
+                v = env->sustain * velocity;
+                frames = 0;
+                break;
+
+            case ENV_RELEASE:
+                dist = v;
+                if (advance_segment(&dist, env->release_lr, 0.0001f, frames, &steps)) {
+                    v = dist;
+                    frames = 0;
+                } else {
+                    v = 0.0f;
+                    st = ENV_IDLE;
+                    frames -= steps;
+                }
+                break;
+
+            case ENV_IDLE:
+            default:
+                v = 0.0f;
+                frames = 0;
+                break;
+        }
+    }
+
+    v = clampf(v, 0.0f, 1.0f);
+    *value = v;
+    *stage = st;
+    return v;
+}
+
+float sh101_env_advance(sh101_env_t *env, int frames) {
+    return sh101_env_advance_state(env, &env->value, &env->stage, env->velocity, frames);
+}
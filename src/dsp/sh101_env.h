@@ -20,6 +20,14 @@ typedef struct {
     float sustain;
     float release_s;
 
+    /* Per-sample multipliers and log2(1 - k), derived in sh101_env_set_adsr(). */
+    float attack_k;
+    float decay_k;
+    float release_k;
+    float attack_lr;
+    float decay_lr;
+    float release_lr;
+
     float value;
     float attack_start;
     float release_start;
@@ -33,6 +41,17 @@ void sh101_env_set_adsr(sh101_env_t *env, float attack_s, float decay_s, float s
 void sh101_env_gate_on(sh101_env_t *env, float velocity);
 void sh101_env_gate_off(sh101_env_t *env);
 float sh101_env_process(sh101_env_t *env);
+/* Same output as `frames` calls to sh101_env_process(), rendered a segment at
+   a time: exponential runs sized from the closed-form sample count, sustain
+   and idle as constant fills. */
+void sh101_env_process_block(sh101_env_t *env, float *out, int frames);
+/* Advances the envelope by `frames` samples in closed form (same curve as
+   calling sh101_env_process() `frames` times) and returns the final value. */
+float sh101_env_advance(sh101_env_t *env, int frames);
+/* sh101_env_advance for state kept outside the envelope (one voice of a
+   pool sharing `env`'s ADSR): reads and updates *value and *stage. */
+float sh101_env_advance_state(const sh101_env_t *env, float *value, sh101_env_stage_t *stage,
+                              float velocity, int frames);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,333 @@
+#ifndef SH101_FASTMATH_H
+#define SH101_FASTMATH_H
+
+/* Polynomial replacements for the libm calls on the render path.
+   Header-only so every translation unit can inline them.
+
+   Max errors measured against libm in tests/unit/test_fastmath.c:
+     sh101_fast_exp2f    x in [-126, 126]     relative error < 3e-7
+     sh101_fast_expf     x in [-87, 87]       relative error < 5e-6  (x * log2(e) rounding)
+     sh101_fast_log2f    x > 0 (normal)       absolute error < 3e-7
+     sh101_fast_powf     b > 0                relative error < 1e-6 * (1 + |e * log2(b)|)
+     sh101_fast_tanhf    all x                absolute error < 5e-7
+     sh101_fast_sin2pif  phase in [-64, 64]   absolute error < 2e-6  (sin(2*pi*phase))
+
+   The *_x4 kernels (NEON on aarch64, SSE2 on x86) and the *_block helpers
+   compute the same polynomials four lanes at a time and agree with the
+   scalar versions to within a couple of ulps. */
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SH101_FASTMATH_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SH101_FASTMATH_SSE2 1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 2^f on [-0.5, 0.5], least-squares fit in relative error. */
+#define SH101_EXP2_C0 1.000000071e+00f
+#define SH101_EXP2_C1 6.931469492e-01f
+#define SH101_EXP2_C2 2.402212175e-01f
+#define SH101_EXP2_C3 5.550742617e-02f
+#define SH101_EXP2_C4 9.675459738e-03f
+#define SH101_EXP2_C5 1.326697022e-03f
+
+/* log2((1+t)/(1-t)) / t on |t| <= 0.1716 (mantissa in [sqrt(0.5), sqrt(2))). */
+#define SH101_LOG2_C0 2.885390261e+00f
+#define SH101_LOG2_C1 9.616152220e-01f
+#define SH101_LOG2_C2 5.949923352e-01f
+
+/* sin(2*pi*x) / x on |x| <= 0.25. */
+#define SH101_SIN_C0 6.283183012e+00f
+#define SH101_SIN_C1 -4.133966611e+01f
+#define SH101_SIN_C2 8.142304152e+01f
+#define SH101_SIN_C3 -7.175399546e+01f
+
+#define SH101_LOG2E 1.442695041f
+
+static inline float sh101_fm_bits_to_float(uint32_t u) {
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+static inline uint32_t sh101_fm_float_to_bits(float f) {
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+static inline float sh101_fast_exp2f(float x) {
+    if (x < -126.0f) x = -126.0f;
+    if (x > 126.0f) x = 126.0f;
+    int32_t k = (int32_t)(x + (x >= 0.0f ? 0.5f : -0.5f));
+    float f = x - (float)k;
+    float p = SH101_EXP2_C5;
+    p = p * f + SH101_EXP2_C4;
+    p = p * f + SH101_EXP2_C3;
+    p = p * f + SH101_EXP2_C2;
+    p = p * f + SH101_EXP2_C1;
+    p = p * f + SH101_EXP2_C0;
+    return sh101_fm_bits_to_float(sh101_fm_float_to_bits(p) + ((uint32_t)k << 23));
+}
+
+static inline float sh101_fast_expf(float x) {
+    return sh101_fast_exp2f(x * SH101_LOG2E);
+}
+
+/* Only defined for positive, normal inputs. */
+static inline float sh101_fast_log2f(float x) {
+    uint32_t u = sh101_fm_float_to_bits(x);
+    /* Re-bias so the mantissa lands in [sqrt(0.5), sqrt(2)). */
+    int32_t e = (int32_t)((u - 0x3F3504F3u) & 0xFF800000u) >> 23;
+    float m = sh101_fm_bits_to_float(u - ((uint32_t)e << 23));
+    float t = (m - 1.0f) / (m + 1.0f);
+    float t2 = t * t;
+    float p = SH101_LOG2_C2;
+    p = p * t2 + SH101_LOG2_C1;
+    p = p * t2 + SH101_LOG2_C0;
+    return (float)e + t * p;
+}
+
+/* base^expo for base > 0. */
+static inline float sh101_fast_powf(float base, float expo) {
+    return sh101_fast_exp2f(expo * sh101_fast_log2f(base));
+}
+
+static inline float sh101_fast_tanhf(float x) {
+    if (x > 9.0f) x = 9.0f;
+    if (x < -9.0f) x = -9.0f;
+    return 1.0f - 2.0f / (1.0f + sh101_fast_exp2f(x * (2.0f * SH101_LOG2E)));
+}
+
+/* sin(2*pi*phase); phase is in cycles. */
+static inline float sh101_fast_sin2pif(float phase) {
+    float x = phase - (float)(int32_t)(phase + (phase >= 0.0f ? 0.5f : -0.5f));
+    float a = x < 0.0f ? -x : x;
+    float r;
+    if (a > 0.25f) a = 0.5f - a;
+    {
+        float a2 = a * a;
+        float p = SH101_SIN_C3;
+        p = p * a2 + SH101_SIN_C2;
+        p = p * a2 + SH101_SIN_C1;
+        p = p * a2 + SH101_SIN_C0;
+        r = a * p;
+    }
+    return x < 0.0f ? -r : r;
+}
+
+/* Decaying state below this magnitude is inaudible (-300 dB) and is
+   flushed to zero at block boundaries before it can go subnormal. */
+#define SH101_FLUSH_TINY 1e-15f
+
+static inline float sh101_flush_tiny(float x) {
+    return (x > -SH101_FLUSH_TINY && x < SH101_FLUSH_TINY) ? 0.0f : x;
+}
+
+#if defined(SH101_FASTMATH_NEON)
+
+typedef float32x4_t sh101_f32x4;
+
+static inline float32x4_t sh101_fast_exp2f_x4(float32x4_t x) {
+    x = vmaxq_f32(vminq_f32(x, vdupq_n_f32(126.0f)), vdupq_n_f32(-126.0f));
+    int32x4_t k = vcvtnq_s32_f32(x);
+    float32x4_t f = vsubq_f32(x, vcvtq_f32_s32(k));
+    float32x4_t p = vdupq_n_f32(SH101_EXP2_C5);
+    p = vfmaq_f32(vdupq_n_f32(SH101_EXP2_C4), p, f);
+    p = vfmaq_f32(vdupq_n_f32(SH101_EXP2_C3), p, f);
+    p = vfmaq_f32(vdupq_n_f32(SH101_EXP2_C2), p, f);
+    p = vfmaq_f32(vdupq_n_f32(SH101_EXP2_C1), p, f);
+    p = vfmaq_f32(vdupq_n_f32(SH101_EXP2_C0), p, f);
+    return vreinterpretq_f32_s32(vaddq_s32(vreinterpretq_s32_f32(p), vshlq_n_s32(k, 23)));
+}
+
+static inline float32x4_t sh101_fast_tanhf_x4(float32x4_t x) {
+    x = vmaxq_f32(vminq_f32(x, vdupq_n_f32(9.0f)), vdupq_n_f32(-9.0f));
+    float32x4_t e = sh101_fast_exp2f_x4(vmulq_n_f32(x, 2.0f * SH101_LOG2E));
+    float32x4_t q = vdivq_f32(vdupq_n_f32(2.0f), vaddq_f32(e, vdupq_n_f32(1.0f)));
+    return vsubq_f32(vdupq_n_f32(1.0f), q);
+}
+
+static inline float32x4_t sh101_fast_sin2pif_x4(float32x4_t phase) {
+    float32x4_t x = vsubq_f32(phase, vrndnq_f32(phase));
+    float32x4_t a = vabsq_f32(x);
+    a = vminq_f32(a, vsubq_f32(vdupq_n_f32(0.5f), a));
+    float32x4_t a2 = vmulq_f32(a, a);
+    float32x4_t p = vdupq_n_f32(SH101_SIN_C3);
+    p = vfmaq_f32(vdupq_n_f32(SH101_SIN_C2), p, a2);
+    p = vfmaq_f32(vdupq_n_f32(SH101_SIN_C1), p, a2);
+    p = vfmaq_f32(vdupq_n_f32(SH101_SIN_C0), p, a2);
+    float32x4_t r = vmulq_f32(a, p);
+    uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(x), vdupq_n_u32(0x80000000u));
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(r), sign));
+}
+
+#define SH101_F32X4_LOAD(p) vld1q_f32(p)
+#define SH101_F32X4_STORE(p, v) vst1q_f32((p), (v))
+#define SH101_F32X4_SPLAT(s) vdupq_n_f32(s)
+#define SH101_F32X4_MUL(a, b) vmulq_f32((a), (b))
+#define SH101_F32X4_ADD(a, b) vaddq_f32((a), (b))
+
+#elif defined(SH101_FASTMATH_SSE2)
+
+typedef __m128 sh101_f32x4;
+
+static inline __m128 sh101_fast_exp2f_x4(__m128 x) {
+    x = _mm_max_ps(_mm_min_ps(x, _mm_set1_ps(126.0f)), _mm_set1_ps(-126.0f));
+    __m128i k = _mm_cvtps_epi32(x); /* round to nearest (default MXCSR) */
+    __m128 f = _mm_sub_ps(x, _mm_cvtepi32_ps(k));
+    __m128 p = _mm_set1_ps(SH101_EXP2_C5);
+    p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(SH101_EXP2_C4));
+    p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(SH101_EXP2_C3));
+    p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(SH101_EXP2_C2));
+    p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(SH101_EXP2_C1));
+    p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(SH101_EXP2_C0));
+    return _mm_castsi128_ps(_mm_add_epi32(_mm_castps_si128(p), _mm_slli_epi32(k, 23)));
+}
+
+static inline __m128 sh101_fast_tanhf_x4(__m128 x) {
+    x = _mm_max_ps(_mm_min_ps(x, _mm_set1_ps(9.0f)), _mm_set1_ps(-9.0f));
+    __m128 e = sh101_fast_exp2f_x4(_mm_mul_ps(x, _mm_set1_ps(2.0f * SH101_LOG2E)));
+    __m128 q = _mm_div_ps(_mm_set1_ps(2.0f), _mm_add_ps(e, _mm_set1_ps(1.0f)));
+    return _mm_sub_ps(_mm_set1_ps(1.0f), q);
+}
+
+static inline __m128 sh101_fast_sin2pif_x4(__m128 phase) {
+    __m128 x = _mm_sub_ps(phase, _mm_cvtepi32_ps(_mm_cvtps_epi32(phase)));
+    __m128 sign_mask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000u));
+    __m128 a = _mm_andnot_ps(sign_mask, x);
+    a = _mm_min_ps(a, _mm_sub_ps(_mm_set1_ps(0.5f), a));
+    __m128 a2 = _mm_mul_ps(a, a);
+    __m128 p = _mm_set1_ps(SH101_SIN_C3);
+    p = _mm_add_ps(_mm_mul_ps(p, a2), _mm_set1_ps(SH101_SIN_C2));
+    p = _mm_add_ps(_mm_mul_ps(p, a2), _mm_set1_ps(SH101_SIN_C1));
+    p = _mm_add_ps(_mm_mul_ps(p, a2), _mm_set1_ps(SH101_SIN_C0));
+    return _mm_xor_ps(_mm_mul_ps(a, p), _mm_and_ps(x, sign_mask));
+}
+
+#define SH101_F32X4_LOAD(p) _mm_loadu_ps(p)
+#define SH101_F32X4_STORE(p, v) _mm_storeu_ps((p), (v))
+#define SH101_F32X4_SPLAT(s) _mm_set1_ps(s)
+#define SH101_F32X4_MUL(a, b) _mm_mul_ps((a), (b))
+#define SH101_F32X4_ADD(a, b) _mm_add_ps((a), (b))
+
+#endif
+
+#if defined(SH101_FASTMATH_NEON) || defined(SH101_FASTMATH_SSE2)
+#define SH101_FASTMATH_SIMD 1
+#endif
+
+/* out[i] = tanh(gain * in[i]); in and out may alias. */
+static inline void sh101_fast_tanhf_block(const float *in, float *out, float gain, int n) {
+    int i = 0;
+#if defined(SH101_FASTMATH_SIMD)
+    sh101_f32x4 g = SH101_F32X4_SPLAT(gain);
+    for (; i + 4 <= n; i += 4) {
+        SH101_F32X4_STORE(out + i, sh101_fast_tanhf_x4(SH101_F32X4_MUL(SH101_F32X4_LOAD(in + i), g)));
+    }
+#endif
+    for (; i < n; ++i) out[i] = sh101_fast_tanhf(gain * in[i]);
+}
+
+/* out[i] = sin(2*pi*phase[i]); phase and out may alias. */
+static inline void sh101_fast_sin2pif_block(const float *phase, float *out, int n) {
+    int i = 0;
+#if defined(SH101_FASTMATH_SIMD)
+    for (; i + 4 <= n; i += 4) {
+        SH101_F32X4_STORE(out + i, sh101_fast_sin2pif_x4(SH101_F32X4_LOAD(phase + i)));
+    }
+#endif
+    for (; i < n; ++i) out[i] = sh101_fast_sin2pif(phase[i]);
+}
+
+/* out[i] = 2^in[i]; in and out may alias. */
+static inline void sh101_fast_exp2f_block(const float *in, float *out, int n) {
+    int i = 0;
+#if defined(SH101_FASTMATH_SIMD)
+    for (; i + 4 <= n; i += 4) {
+        SH101_F32X4_STORE(out + i, sh101_fast_exp2f_x4(SH101_F32X4_LOAD(in + i)));
+    }
+#endif
+    for (; i < n; ++i) out[i] = sh101_fast_exp2f(in[i]);
+}
+
+/* Full-scale int16 for a float in [-1, 1], truncated toward zero. */
+static inline int16_t sh101_s16_from_float(float x) {
+    x = x < -1.0f ? -1.0f : (x > 1.0f ? 1.0f : x);
+    return (int16_t)(x * 32767.0f);
+}
+
+static inline int16_t sh101_s16_add_sat(int16_t a, int16_t b) {
+    int32_t s = (int32_t)a + (int32_t)b;
+    return (int16_t)(s < -32768 ? -32768 : (s > 32767 ? 32767 : s));
+}
+
+/* Mono float -> interleaved L/R int16, the same sample on both channels.
+   mix = 0 overwrites out_lr, mix = 1 adds to it with int16 saturation. */
+static inline void sh101_s16_stereo_block(const float *in, int16_t *out_lr, int n, int mix) {
+    int i = 0;
+#if defined(SH101_FASTMATH_NEON)
+    float32x4_t lo = vdupq_n_f32(-1.0f);
+    float32x4_t hi = vdupq_n_f32(1.0f);
+    float32x4_t scale = vdupq_n_f32(32767.0f);
+    for (; i + 8 <= n; i += 8) {
+        float32x4_t a = vminq_f32(vmaxq_f32(vld1q_f32(in + i), lo), hi);
+        float32x4_t b = vminq_f32(vmaxq_f32(vld1q_f32(in + i + 4), lo), hi);
+        int16x8_t s = vcombine_s16(vqmovn_s32(vcvtq_s32_f32(vmulq_f32(a, scale))),
+                                   vqmovn_s32(vcvtq_s32_f32(vmulq_f32(b, scale))));
+        int16x8x2_t lr;
+        if (mix) {
+            lr = vld2q_s16(out_lr + i * 2);
+            lr.val[0] = vqaddq_s16(lr.val[0], s);
+            lr.val[1] = vqaddq_s16(lr.val[1], s);
+        } else {
+            lr.val[0] = s;
+            lr.val[1] = s;
+        }
+        vst2q_s16(out_lr + i * 2, lr);
+    }
+#elif defined(SH101_FASTMATH_SSE2)
+    __m128 lo = _mm_set1_ps(-1.0f);
+    __m128 hi = _mm_set1_ps(1.0f);
+    __m128 scale = _mm_set1_ps(32767.0f);
+    for (; i + 8 <= n; i += 8) {
+        __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i), lo), hi);
+        __m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i + 4), lo), hi);
+        __m128i s = _mm_packs_epi32(_mm_cvttps_epi32(_mm_mul_ps(a, scale)),
+                                    _mm_cvttps_epi32(_mm_mul_ps(b, scale)));
+        __m128i l = _mm_unpacklo_epi16(s, s);
+        __m128i r = _mm_unpackhi_epi16(s, s);
+        __m128i *dst = (__m128i *)(void *)(out_lr + i * 2);
+        if (mix) {
+            l = _mm_adds_epi16(_mm_loadu_si128(dst), l);
+            r = _mm_adds_epi16(_mm_loadu_si128(dst + 1), r);
+        }
+        _mm_storeu_si128(dst, l);
+        _mm_storeu_si128(dst + 1, r);
+    }
+#endif
+    for (; i < n; ++i) {
+        int16_t s = sh101_s16_from_float(in[i]);
+        if (mix) {
+            out_lr[i * 2] = sh101_s16_add_sat(out_lr[i * 2], s);
+            out_lr[i * 2 + 1] = sh101_s16_add_sat(out_lr[i * 2 + 1], s);
+        } else {
+            out_lr[i * 2] = s;
+            out_lr[i * 2 + 1] = s;
+        }
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,5 +1,8 @@
 #include "sh101_filter.h"
 
+#include "sh101_adaa.h"
+#include "sh101_fastmath.h"
+
 #include <math.h>
 
 static float clampf(float v, float lo, float hi) {
@@ -8,22 +11,95 @@ static float clampf(float v, float lo, float hi) {
     return v;
 }
 
-static float sat(float x) {
-    return tanhf(1.5f * x);
+/* `prev` is the previous input, kept in the filter state for ADAA.  The
+   plain path records it too so the mode can switch without a click. */
+static inline float sat(float *prev, float x, const int adaa) {
+    if (adaa) return sh101_adaa_tanh(prev, 1.5f * x);
+    *prev = 1.5f * x;
+    return sh101_fast_tanhf(1.5f * x);
 }
 
 /* Mild cubic soft-clip mimics CEM3320 OTA stage nonlinearity. */
-static float stage_sat(float x) {
+static inline float stage_sat(float *prev, float x, const int adaa) {
+    if (adaa) return sh101_adaa_cubic(prev, x, 0.06f);
+    *prev = x;
     return x - 0.06f * x * x * x;
 }
 
+static void clear_state(sh101_filter_t *f) {
+    f->y1 = f->y2 = f->y3 = f->y4 = 0.0f;
+    f->sat_prev = 0.0f;
+    f->stage_prev[0] = f->stage_prev[1] = f->stage_prev[2] = 0.0f;
+}
+
+/* TPT one-pole gain G = tan(wc/2) / (1 + tan(wc/2)) sampled over wc in
+   [0, pi].  G is bounded and smooth, so linear interpolation stays within
+   1e-5 of the exact prewarp.  Built once per process. */
+#define PREWARP_SIZE 512
+#define PREWARP_SCALE ((float)PREWARP_SIZE / 3.14159265359f)
+static float g_prewarp[PREWARP_SIZE + 2];
+static int g_prewarp_ready;
+
+static void build_prewarp_table(void) {
+    if (g_prewarp_ready) return;
+    for (int i = 0; i < PREWARP_SIZE; ++i) {
+        double t = tan(0.5 * 3.14159265358979 * (double)i / (double)PREWARP_SIZE);
+        g_prewarp[i] = (float)(t / (1.0 + t));
+    }
+    g_prewarp[PREWARP_SIZE] = 1.0f;
+    g_prewarp[PREWARP_SIZE + 1] = 1.0f;
+    g_prewarp_ready = 1;
+}
+
+static inline float prewarp_gain(float wc) {
+    float x = wc * PREWARP_SCALE;
+    int i = (int)x;
+    float frac = x - (float)i;
+    return g_prewarp[i] + (g_prewarp[i + 1] - g_prewarp[i]) * frac;
+}
+
+/* Highest Euler ladder cutoff: the g = 0.35 cap the voicing was tuned
+   with at 44.1 kHz. */
+#define EULER_CAP_HZ 2456.6f
+
+static void update_g_limits(sh101_filter_t *f) {
+    /* The ZDF ladder is stable up to Nyquist; keep a small margin below it.
+       The Euler cap is a cutoff, so the voicing does not move with the
+       sample rate or oversampling. */
+    float cap = (f->model == SH101_FILTER_ZDF) ? 0.95f * 3.14159265359f
+                                               : EULER_CAP_HZ * f->wc_per_hz;
+    f->g_min = clampf(20.0f * f->wc_per_hz, 0.0005f, cap);
+    f->g_max = clampf(18000.0f * f->wc_per_hz, 0.0005f, cap);
+}
+
 void sh101_filter_init(sh101_filter_t *f, float sample_rate) {
     f->sample_rate = sample_rate;
     f->cutoff_hz = 1200.0f;
     f->resonance = 0.2f;
     f->drive = 1.0f;
     f->g = 0.05f;
-    f->y1 = f->y2 = f->y3 = f->y4 = 0.0f;
+    f->wc_per_hz = 2.0f * 3.14159265359f / sample_rate;
+    f->model = SH101_FILTER_EULER;
+    f->adaa = 0;
+    sh101_noise_seed(&f->noise, 0x2545f491u);
+    update_g_limits(f);
+    clear_state(f);
+    build_prewarp_table();
+    sh101_adaa_init();
+}
+
+void sh101_filter_set_sample_rate(sh101_filter_t *f, float sample_rate) {
+    f->sample_rate = sample_rate;
+    f->wc_per_hz = 2.0f * 3.14159265359f / sample_rate;
+    update_g_limits(f);
+    f->g = clampf(f->cutoff_hz * f->wc_per_hz, f->g_min, f->g_max);
+}
+
+void sh101_filter_set_model(sh101_filter_t *f, sh101_filter_model_t model) {
+    f->model = (model == SH101_FILTER_ZDF) ? SH101_FILTER_ZDF : SH101_FILTER_EULER;
+    update_g_limits(f);
+    f->g = clampf(f->cutoff_hz * f->wc_per_hz, f->g_min, f->g_max);
+    clear_state(f);
 }
 
 void sh101_filter_set_params(sh101_filter_t *f, float cutoff_hz, float resonance, float drive) {
@@ -31,30 +107,133 @@ void sh101_filter_set_params(sh101_filter_t *f, float cutoff_hz, float resonance
     f->resonance = clampf(resonance, 0.0f, 1.2f);
     f->drive = clampf(drive, 0.3f, 4.0f);
 
-    float wc = 2.0f * 3.14159265359f * f->cutoff_hz / f->sample_rate;
-    f->g = clampf(wc, 0.0005f, 0.35f);
+    f->g = clampf(f->cutoff_hz * f->wc_per_hz, f->g_min, f->g_max);
 }
 
-float sh101_filter_process(sh101_filter_t *f, float in) {
-    /* Higher resonance naturally reduces perceived low-end/level in vintage behavior. */
-    float res = clampf(f->resonance, 0.0f, 1.2f);
-    float input_gain = 1.0f - 0.22f * res;
-    /* Steepen feedback above res>1.0 to compensate for Euler integration
-       energy loss that prevents the digital filter from reaching the
-       analog CEM3320's self-oscillation behavior at max Q. */
+/* Higher resonance naturally reduces perceived low-end/level in vintage behavior. */
+static float input_gain_for(float res) {
+    return 1.0f - 0.22f * res;
+}
+
+/* Steepen feedback above res>1.0 to compensate for Euler integration
+   energy loss that prevents the digital filter from reaching the
+   analog CEM3320's self-oscillation behavior at max Q. */
+static float feedback_for(float res) {
     float fb_coeff = 1.20f;
     if (res > 1.0f)
         fb_coeff += (res - 1.0f) * 12.0f;
-    float fb = (fb_coeff * res) * (f->y4 - 0.15f * f->y3);
-    float x = sat((in * input_gain - fb) * f->drive);
+    return fb_coeff * res;
+}
+
+static inline float ladder_tick(sh101_filter_t *f, float in, float input_gain, float fb_gain, const int adaa) {
+    float fb = fb_gain * (f->y4 - 0.15f * f->y3);
+    float x = sat(&f->sat_prev, (in * input_gain - fb) * f->drive, adaa);
 
     f->y1 += f->g * (x - f->y1);
-    f->y1 = stage_sat(f->y1);
+    f->y1 = stage_sat(&f->stage_prev[0], f->y1, adaa);
     f->y2 += f->g * (f->y1 - f->y2);
-    f->y2 = stage_sat(f->y2);
+    f->y2 = stage_sat(&f->stage_prev[1], f->y2, adaa);
     f->y3 += f->g * (f->y2 - f->y3);
-    f->y3 = stage_sat(f->y3);
+    f->y3 = stage_sat(&f->stage_prev[2], f->y3, adaa);
     f->y4 += f->g * (f->y3 - f->y4);
 
     return f->y4;
 }
+
+/* Loop gain of the ZDF input stage is 1.5 * drive (the sat() slope), so
+   k = 4 / loop_gain puts the self-oscillation threshold at res = 1. */
+static float zdf_k_for(const sh101_filter_t *f, float res) {
+    return res * 4.0f / (1.5f * f->drive);
+}
+
+/* Amplitude of the ZDF noise floor added to the input. */
+#define ZDF_NOISE_FLOOR 1.0e-6f
+/* Noise floor samples rendered ahead of each ZDF block pass. */
+#define ZDF_NOISE_CHUNK 64
+
+/* Linear TPT ladder solved for the input node, with the tanh input stage
+   applied to the solved value.  G comes from the prewarp table; `in`
+   already carries the noise floor. */
+static inline float zdf_tick(sh101_filter_t *f, float in, float input_gain, float k, float G) {
+    float G2 = G * G;
+    float one_minus_G = 1.0f - G;
+    float loop = 1.5f * f->drive;
+    float S = (G2 * G * f->y1 + G2 * f->y2 + G * f->y3 + f->y4) * one_minus_G;
+    float u, v;
+
+    u = loop * (in * input_gain - k * S) / (1.0f + loop * k * G2 * G2);
+    u = sh101_fast_tanhf(u);
+
+    v = (u - f->y1) * G; u = v + f->y1; f->y1 = u + v;
+    v = (u - f->y2) * G; u = v + f->y2; f->y2 = u + v;
+    v = (u - f->y3) * G; u = v + f->y3; f->y3 = u + v;
+    v = (u - f->y4) * G; u = v + f->y4; f->y4 = u + v;
+    return u;
+}
+
+float sh101_filter_process(sh101_filter_t *f, float in) {
+    float res = clampf(f->resonance, 0.0f, 1.2f);
+    if (f->model == SH101_FILTER_ZDF) {
+        in += sh101_noise_next(&f->noise) * ZDF_NOISE_FLOOR;
+        return zdf_tick(f, in, input_gain_for(res), zdf_k_for(f, res), prewarp_gain(f->g));
+    }
+    if (f->adaa) return ladder_tick(f, in, input_gain_for(res), feedback_for(res), 1);
+    return ladder_tick(f, in, input_gain_for(res), feedback_for(res), 0);
+}
+
+void sh101_filter_process_block(sh101_filter_t *f, const float *in, const float *g, float *out, int frames) {
+    float res = clampf(f->resonance, 0.0f, 1.2f);
+    float input_gain = input_gain_for(res);
+    float fb_gain = feedback_for(res);
+
+    if (f->model == SH101_FILTER_ZDF) {
+        float k = zdf_k_for(f, res);
+        float noise[ZDF_NOISE_CHUNK];
+        for (int done = 0; done < frames; ) {
+            int n = frames - done;
+            if (n > ZDF_NOISE_CHUNK) n = ZDF_NOISE_CHUNK;
+            sh101_noise_block(&f->noise, noise, n);
+            for (int i = 0; i < n; ++i) {
+                f->g = clampf(g[done + i], f->g_min, f->g_max);
+                out[done + i] = zdf_tick(f, in[done + i] + noise[i] * ZDF_NOISE_FLOOR, input_gain, k,
+                                         prewarp_gain(f->g));
+            }
+            done += n;
+        }
+        if (frames > 0) f->cutoff_hz = clampf(g[frames - 1] / f->wc_per_hz, 20.0f, 18000.0f);
+        return;
+    }
+
+    if (f->adaa) {
+        for (int i = 0; i < frames; ++i) {
+            f->g = clampf(g[i], f->g_min, f->g_max);
+            out[i] = ladder_tick(f, in[i], input_gain, fb_gain, 1);
+        }
+    } else {
+        for (int i = 0; i < frames; ++i) {
+            f->g = clampf(g[i], f->g_min, f->g_max);
+            out[i] = ladder_tick(f, in[i], input_gain, fb_gain, 0);
+        }
+    }
+    if (frames > 0) f->cutoff_hz = clampf(g[frames - 1] / f->wc_per_hz, 20.0f, 18000.0f);
+}
+
+void sh101_filter_ladder_coefs(const sh101_filter_t *f, float *input_gain, float *feedback) {
+    float res = clampf(f->resonance, 0.0f, 1.2f);
+    *input_gain = input_gain_for(res);
+    *feedback = (f->model == SH101_FILTER_ZDF) ? zdf_k_for(f, res) : feedback_for(res);
+}
+
+float sh101_filter_stage_gain(const sh101_filter_t *f, float g) {
+    g = clampf(g, f->g_min, f->g_max);
+    return (f->model == SH101_FILTER_ZDF) ? prewarp_gain(g) : g;
+}
+
+void sh101_filter_flush_denormals(sh101_filter_t *f) {
+    f->y1 = sh101_flush_tiny(f->y1);
+    f->y2 = sh101_flush_tiny(f->y2);
+    f->y3 = sh101_flush_tiny(f->y3);
+    f->y4 = sh101_flush_tiny(f->y4);
+    f->sat_prev = sh101_flush_tiny(f->sat_prev);
+    for (int i = 0; i < 3; ++i) f->stage_prev[i] = sh101_flush_tiny(f->stage_prev[i]);
+}
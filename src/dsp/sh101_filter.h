@@ -1,10 +1,19 @@
 #ifndef SH101_FILTER_H
 #define SH101_FILTER_H
 
+#include <stdint.h>
+
+#include "sh101_noise.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+typedef enum {
+    SH101_FILTER_EULER = 0, /* calibrated explicit-Euler ladder, cutoff capped near 2.5 kHz */
+    SH101_FILTER_ZDF = 1    /* zero-delay-feedback (TPT) ladder, tracks to Nyquist */
+} sh101_filter_model_t;
+
 typedef struct {
     float sample_rate;
     float cutoff_hz;
@@ -12,15 +21,51 @@ typedef struct {
     float drive;
 
     float g;
+    float wc_per_hz; /* 2*pi / sample_rate */
+    float g_min;     /* coefficient limits, including the 20..18000 Hz range */
+    float g_max;
+    sh101_filter_model_t model;
+    sh101_noise_t noise;  /* ZDF noise floor that seeds self-oscillation */
+    /* Nonzero: antiderivative anti-aliased saturators in the Euler ladder.
+       ADAA adds half a sample to the feedback loop, so the ladder
+       self-oscillates more readily at high cutoffs than the calibrated
+       default. */
+    int adaa;
+    /* Stage outputs (Euler) or integrator states (ZDF). */
     float y1;
     float y2;
     float y3;
     float y4;
+    /* Previous saturator inputs for ADAA (Euler ladder). */
+    float sat_prev;
+    float stage_prev[3];
 } sh101_filter_t;
 
 void sh101_filter_init(sh101_filter_t *f, float sample_rate);
 void sh101_filter_set_params(sh101_filter_t *f, float cutoff_hz, float resonance, float drive);
+/* Changes the processing rate (e.g. for oversampling), keeping the state. */
+void sh101_filter_set_sample_rate(sh101_filter_t *f, float sample_rate);
+/* Switches the ladder model and clears its state. */
+void sh101_filter_set_model(sh101_filter_t *f, sh101_filter_model_t model);
 float sh101_filter_process(sh101_filter_t *f, float in);
+/* Unclamped one-pole coefficient for `cutoff_hz`; block callers ramp and
+   modulate in this domain and let sh101_filter_process_block clamp. */
+static inline float sh101_filter_cutoff_to_g(const sh101_filter_t *f, float cutoff_hz) {
+    return cutoff_hz * f->wc_per_hz;
+}
+/* Filters `frames` samples with a per-sample coefficient `g` (see
+   sh101_filter_cutoff_to_g); resonance and drive come from the last
+   sh101_filter_set_params() call. */
+void sh101_filter_process_block(sh101_filter_t *f, const float *in, const float *g, float *out, int frames);
+/* For callers running their own copies of the ladder (the poly voices):
+   the input gain and the Euler feedback gain or ZDF k at the current
+   resonance and drive. */
+void sh101_filter_ladder_coefs(const sh101_filter_t *f, float *input_gain, float *feedback);
+/* Stage gain for coefficient `g` in the current model: clamped to the
+   model's range and, for ZDF, prewarped. */
+float sh101_filter_stage_gain(const sh101_filter_t *f, float g);
+/* Zeroes decayed state (see SH101_FLUSH_TINY); call between blocks. */
+void sh101_filter_flush_denormals(sh101_filter_t *f);
 
 #ifdef __cplusplus
 }
@@ -1,5 +1,7 @@
 #include "sh101_lfo.h"
 
+#include <stddef.h>
+
 static float clampf(float v, float lo, float hi) {
     if (v < lo) return lo;
     if (v > hi) return hi;
@@ -8,21 +10,124 @@ static float clampf(float v, float lo, float hi) {
 
 void sh101_lfo_init(sh101_lfo_t *lfo, float sample_rate) {
     lfo->sample_rate = sample_rate;
-    lfo->rate_hz = 5.0f;
     lfo->phase = 0.0f;
+    lfo->waveform = SH101_LFO_WAVE_TRI;
+    lfo->invert = 0;
+    lfo->sh_value = 0.0f;
+    lfo->positive = 0;
+    sh101_lfo_set_rate_hz(lfo, 5.0f);
+    sh101_lfo_seed(lfo, 0x4c464f31u);
 }
 
 void sh101_lfo_set_rate_hz(sh101_lfo_t *lfo, float rate_hz) {
     lfo->rate_hz = clampf(rate_hz, 0.02f, 40.0f);
+    lfo->inc = lfo->rate_hz / lfo->sample_rate;
 }
 
-float sh101_lfo_process(sh101_lfo_t *lfo) {
-    float inc = lfo->rate_hz / lfo->sample_rate;
-    lfo->phase += inc;
-    if (lfo->phase >= 1.0f) lfo->phase -= 1.0f;
+void sh101_lfo_seed(sh101_lfo_t *lfo, uint32_t seed) {
+    sh101_noise_seed(&lfo->rng, seed);
+}
 
+static float triangle(float x) {
     /* Triangle wave in [-1, 1] */
-    float x = lfo->phase;
-    float tri = (x < 0.5f) ? (x * 4.0f - 1.0f) : (3.0f - x * 4.0f);
-    return tri;
+    return (x < 0.5f) ? (x * 4.0f - 1.0f) : (3.0f - x * 4.0f);
+}
+
+static void note_event(int *count, int *list, int i) {
+    if (*count < SH101_LFO_MAX_EVENTS) list[(*count)++] = i;
+}
+
+/* Per-waveform kernels: phase accumulation with wrap recording, output
+   scaled by `pol` (+1 or -1 for invert). */
+
+static void kernel_tri(sh101_lfo_t *lfo, float *out, int frames, float pol, sh101_lfo_events_t *ev) {
+    float phase = lfo->phase;
+    float inc = lfo->inc;
+    for (int i = 0; i < frames; ++i) {
+        phase += inc;
+        if (phase >= 1.0f) {
+            phase -= 1.0f;
+            if (ev) note_event(&ev->wrap_count, ev->wrap, i);
+        }
+        out[i] = pol * triangle(phase);
+    }
+    lfo->phase = phase;
+}
+
+static void kernel_rect(sh101_lfo_t *lfo, float *out, int frames, float pol, sh101_lfo_events_t *ev) {
+    float phase = lfo->phase;
+    float inc = lfo->inc;
+    for (int i = 0; i < frames; ++i) {
+        phase += inc;
+        if (phase >= 1.0f) {
+            phase -= 1.0f;
+            if (ev) note_event(&ev->wrap_count, ev->wrap, i);
+        }
+        out[i] = (phase < 0.5f) ? pol : -pol;
+    }
+    lfo->phase = phase;
+}
+
+/* Between wraps the output is a constant fill. */
+static void kernel_random(sh101_lfo_t *lfo, float *out, int frames, float pol, sh101_lfo_events_t *ev) {
+    float phase = lfo->phase;
+    float inc = lfo->inc;
+    float level = pol * lfo->sh_value;
+    for (int i = 0; i < frames; ++i) {
+        phase += inc;
+        if (phase >= 1.0f) {
+            phase -= 1.0f;
+            lfo->sh_value = sh101_noise_next(&lfo->rng);
+            level = pol * lfo->sh_value;
+            if (ev) note_event(&ev->wrap_count, ev->wrap, i);
+        }
+        out[i] = level;
+    }
+    lfo->phase = phase;
+}
+
+static void kernel_noise(sh101_lfo_t *lfo, float *out, int frames, float pol, sh101_lfo_events_t *ev) {
+    kernel_tri(lfo, out, frames, pol, ev); /* phase and wraps only */
+    sh101_noise_block(&lfo->rng, out, frames);
+    if (pol < 0.0f) {
+        for (int i = 0; i < frames; ++i) out[i] = -out[i];
+    }
+}
+
+void sh101_lfo_render_block(sh101_lfo_t *lfo, float *out, int frames, sh101_lfo_events_t *events) {
+    float pol = lfo->invert ? -1.0f : 1.0f;
+    if (events) {
+        events->wrap_count = 0;
+        events->edge_count = 0;
+    }
+    if (frames <= 0) return;
+
+    switch (lfo->waveform) {
+        case SH101_LFO_WAVE_RECT: kernel_rect(lfo, out, frames, pol, events); break;
+        case SH101_LFO_WAVE_RANDOM: kernel_random(lfo, out, frames, pol, events); break;
+        case SH101_LFO_WAVE_NOISE: kernel_noise(lfo, out, frames, pol, events); break;
+        default: kernel_tri(lfo, out, frames, pol, events); break;
+    }
+
+    if (events) {
+        int positive = lfo->positive;
+        for (int i = 0; i < frames; ++i) {
+            int p = out[i] > 0.0f;
+            if (p != positive) {
+                note_event(&events->edge_count, events->edge, i);
+                positive = p;
+            }
+        }
+    }
+    lfo->positive = out[frames - 1] > 0.0f;
+}
+
+void sh101_lfo_process_block(sh101_lfo_t *lfo, float *out, int frames) {
+    sh101_lfo_render_block(lfo, out, frames, NULL);
+}
+
+float sh101_lfo_process(sh101_lfo_t *lfo) {
+    float out;
+    sh101_lfo_render_block(lfo, &out, 1, NULL);
+    return out;
 }
@@ -1,18 +1,50 @@
 #ifndef SH101_LFO_H
 #define SH101_LFO_H
 
+#include "sh101_noise.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+typedef enum {
+    SH101_LFO_WAVE_TRI = 0,
+    SH101_LFO_WAVE_RECT = 1,
+    SH101_LFO_WAVE_RANDOM = 2,  /* sample & hold, new level on each phase wrap */
+    SH101_LFO_WAVE_NOISE = 3    /* new level every sample */
+} sh101_lfo_waveform_t;
+
+/* Most wraps / edges recorded per block; later ones in the same block are
+   dropped (only the noise waveform can produce more). */
+#define SH101_LFO_MAX_EVENTS 8
+
+/* Sample offsets within the block last rendered. */
+typedef struct {
+    int wrap_count;
+    int wrap[SH101_LFO_MAX_EVENTS];  /* phase wrapped at this sample */
+    int edge_count;
+    int edge[SH101_LFO_MAX_EVENTS];  /* first sample whose sign (> 0) differs from the one before */
+} sh101_lfo_events_t;
+
 typedef struct {
     float sample_rate;
     float rate_hz;
+    float inc;          /* rate_hz / sample_rate, kept by sh101_lfo_set_rate_hz */
     float phase;
+    int waveform;       /* sh101_lfo_waveform_t */
+    int invert;         /* 1 = output negated */
+    float sh_value;     /* held level of the random waveform */
+    int positive;       /* last output sample was > 0 */
+    sh101_noise_t rng;  /* random and noise levels */
 } sh101_lfo_t;
 
 void sh101_lfo_init(sh101_lfo_t *lfo, float sample_rate);
 void sh101_lfo_set_rate_hz(sh101_lfo_t *lfo, float rate_hz);
+void sh101_lfo_seed(sh101_lfo_t *lfo, uint32_t seed);
+/* Renders `frames` samples of the current waveform (inverted if set) and,
+   when `events` is not NULL, fills it with the wrap and edge offsets. */
+void sh101_lfo_render_block(sh101_lfo_t *lfo, float *out, int frames, sh101_lfo_events_t *events);
+void sh101_lfo_process_block(sh101_lfo_t *lfo, float *out, int frames);
 float sh101_lfo_process(sh101_lfo_t *lfo);
 
 #ifdef __cplusplus
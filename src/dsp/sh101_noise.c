@@ -0,0 +1,133 @@
+#include "sh101_noise.h"
+
+#include "sh101_fastmath.h"
+
+#include <math.h>
+
+#define NOISE_SCALE (1.0f / 2147483648.0f)
+
+static uint32_t splitmix32(uint32_t *x) {
+    uint32_t z = (*x += 0x9e3779b9u);
+    z = (z ^ (z >> 16)) * 0x85ebca6bu;
+    z = (z ^ (z >> 13)) * 0xc2b2ae35u;
+    return z ^ (z >> 16);
+}
+
+static inline uint32_t xorshift32(uint32_t x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+void sh101_noise_seed(sh101_noise_t *n, uint32_t seed) {
+    for (int l = 0; l < 4; ++l) {
+        uint32_t s = splitmix32(&seed);
+        n->lane[l] = s ? s : 0x6d2b79f5u;
+        n->cur[l] = 0.0f;
+    }
+    n->pos = 4;
+}
+
+void sh101_noise_refill(sh101_noise_t *n) {
+    for (int l = 0; l < 4; ++l) {
+        n->lane[l] = xorshift32(n->lane[l]);
+        n->cur[l] = (float)(int32_t)n->lane[l] * NOISE_SCALE;
+    }
+    n->pos = 0;
+}
+
+void sh101_noise_block(sh101_noise_t *n, float *out, int frames) {
+    int i = 0;
+    while (i < frames && n->pos < 4) out[i++] = n->cur[n->pos++];
+#if defined(SH101_FASTMATH_NEON)
+    if (i + 4 <= frames) {
+        uint32x4_t x = vld1q_u32(n->lane);
+        for (; i + 4 <= frames; i += 4) {
+            x = veorq_u32(x, vshlq_n_u32(x, 13));
+            x = veorq_u32(x, vshrq_n_u32(x, 17));
+            x = veorq_u32(x, vshlq_n_u32(x, 5));
+            vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(vreinterpretq_s32_u32(x)), NOISE_SCALE));
+        }
+        vst1q_u32(n->lane, x);
+    }
+#elif defined(SH101_FASTMATH_SSE2)
+    if (i + 4 <= frames) {
+        __m128i x = _mm_loadu_si128((const __m128i *)n->lane);
+        __m128 scale = _mm_set1_ps(NOISE_SCALE);
+        for (; i + 4 <= frames; i += 4) {
+            x = _mm_xor_si128(x, _mm_slli_epi32(x, 13));
+            x = _mm_xor_si128(x, _mm_srli_epi32(x, 17));
+            x = _mm_xor_si128(x, _mm_slli_epi32(x, 5));
+            _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(x), scale));
+        }
+        _mm_storeu_si128((__m128i *)n->lane, x);
+    }
+#endif
+    for (; i < frames; ++i) out[i] = sh101_noise_next(n);
+}
+
+float sh101_noise_lp_coef(float sample_rate) {
+    return 1.0f - expf(-6.28318530718f * SH101_NOISE_LP_HZ / sample_rate);
+}
+
+void sh101_noise_colored_block(sh101_noise_t *n, float *lp, float a, float color, float *out, int frames) {
+    const float d = 1.0f - a;
+    float y = *lp;
+    int i = 0;
+
+    sh101_noise_block(n, out, frames);
+
+#if defined(SH101_FASTMATH_SIMD)
+    /* Four one-pole steps per iteration as a two-step prefix scan:
+       y[l] = sum_{j<=l} a*w[j]*d^(l-j) + y_prev*d^(l+1). */
+    {
+        const float d2 = d * d;
+        const float lp_d[4] = {d, d2, d2 * d, d2 * d2};
+#if defined(SH101_FASTMATH_NEON)
+        float32x4_t z = vdupq_n_f32(0.0f);
+        float32x4_t dv = vld1q_f32(lp_d);
+        float32x4_t yv = vdupq_n_f32(y);
+        for (; i + 4 <= frames; i += 4) {
+            float32x4_t w = vld1q_f32(out + i);
+            float32x4_t t = vmulq_n_f32(w, a);
+            t = vmlaq_n_f32(t, vextq_f32(z, t, 3), d);
+            t = vmlaq_n_f32(t, vextq_f32(z, t, 2), d2);
+            yv = vmlaq_f32(t, vdupq_laneq_f32(yv, 3), dv);
+            {
+                float32x4_t colored = vmlaq_n_f32(vmulq_n_f32(yv, 0.72f), w, 0.28f);
+                vst1q_f32(out + i, vmlaq_n_f32(colored, vsubq_f32(w, colored), color));
+            }
+        }
+        y = vgetq_lane_f32(yv, 3);
+#else
+        __m128 dv = _mm_loadu_ps(lp_d);
+        __m128 yv = _mm_set1_ps(y);
+        for (; i + 4 <= frames; i += 4) {
+            __m128 w = _mm_loadu_ps(out + i);
+            __m128 t = _mm_mul_ps(w, _mm_set1_ps(a));
+            t = _mm_add_ps(t, _mm_mul_ps(_mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(t), 4)), _mm_set1_ps(d)));
+            t = _mm_add_ps(t, _mm_mul_ps(_mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(t), 8)), _mm_set1_ps(d2)));
+            yv = _mm_add_ps(t, _mm_mul_ps(_mm_shuffle_ps(yv, yv, _MM_SHUFFLE(3, 3, 3, 3)), dv));
+            {
+                __m128 colored = _mm_add_ps(_mm_mul_ps(yv, _mm_set1_ps(0.72f)), _mm_mul_ps(w, _mm_set1_ps(0.28f)));
+                _mm_storeu_ps(out + i, _mm_add_ps(colored, _mm_mul_ps(_mm_sub_ps(w, colored), _mm_set1_ps(color))));
+            }
+        }
+        {
+            float tmp[4];
+            _mm_storeu_ps(tmp, yv);
+            y = tmp[3];
+        }
+#endif
+    }
+#endif
+    for (; i < frames; ++i) {
+        float w = out[i];
+        float colored;
+        y += a * (w - y);
+        colored = 0.72f * y + 0.28f * w;
+        out[i] = colored + (w - colored) * color;
+    }
+    *lp = y;
+}
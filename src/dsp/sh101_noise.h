@@ -0,0 +1,58 @@
+#ifndef SH101_NOISE_H
+#define SH101_NOISE_H
+
+/* Block noise streams.  Each stream is four xorshift32 generators, one per
+   SIMD lane, read out lane by lane: sample 4j + l is lane l after j + 1
+   steps.  Block fills step all four lanes at once; the scalar reader steps
+   them every fourth call, so any mix of block sizes and single draws gives
+   the same sequence for a given seed. */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t lane[4];
+    float cur[4]; /* outputs of the last lane step */
+    int pos;      /* next unread entry of cur; 4 = step the lanes first */
+} sh101_noise_t;
+
+/* Corner of the coloured-noise one-pole lowpass (0.085 per sample at
+   44.1 kHz); see sh101_noise_lp_coef. */
+#define SH101_NOISE_LP_HZ 623.5f
+
+/* Derives four nonzero lane states from `seed` (splitmix32). */
+void sh101_noise_seed(sh101_noise_t *n, uint32_t seed);
+/* Steps the lanes into cur; used by sh101_noise_next. */
+void sh101_noise_refill(sh101_noise_t *n);
+/* Fills `out` with uniform noise in [-1, 1). */
+void sh101_noise_block(sh101_noise_t *n, float *out, int frames);
+/* One-pole coefficient for a SH101_NOISE_LP_HZ corner at `sample_rate`. */
+float sh101_noise_lp_coef(float sample_rate);
+/* Fills `out` with the oscillator's noise voice: white noise through the
+   one-pole with coefficient `a` (state `lp`), blended from 72/28
+   lowpassed/white at color 0 to pure white at color 1. */
+void sh101_noise_colored_block(sh101_noise_t *n, float *lp, float a, float color, float *out, int frames);
+
+/* Uniform noise in [-1, 1). */
+static inline float sh101_noise_next(sh101_noise_t *n) {
+    if (n->pos >= 4) sh101_noise_refill(n);
+    return n->cur[n->pos++];
+}
+
+/* Scalar sh101_noise_colored_block. */
+static inline float sh101_noise_colored_next(sh101_noise_t *n, float *lp, float a, float color) {
+    float white = sh101_noise_next(n);
+    float colored;
+    *lp += a * (white - *lp);
+    colored = 0.72f * *lp + 0.28f * white;
+    return colored + (white - colored) * color;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,6 +1,15 @@
 #include "sh101_osc.h"
 
-#include <math.h>
+#include "sh101_adaa.h"
+#include "sh101_cpu.h"
+#include "sh101_fastmath.h"
+
+#include <string.h>
+
+#if defined(SH101_CPU_X86_DISPATCH) && defined(SH101_FASTMATH_SSE2)
+#include <immintrin.h>
+#define OSC_X86_VARIANTS 1
+#endif
 
 static float clampf(float v, float lo, float hi) {
     if (v < lo) return lo;
@@ -8,22 +17,131 @@ static float clampf(float v, float lo, float hi) {
     return v;
 }
 
-static float soft_sat(float x) {
-    return tanhf(1.4f * x);
+/* The plain path records the previous input too, so the mode can switch
+   without a click. */
+static float soft_sat(sh101_osc_t *osc, float x) {
+    if (osc->adaa) return sh101_adaa_tanh(&osc->sat_prev, 1.4f * x);
+    osc->sat_prev = 1.4f * x;
+    return sh101_fast_tanhf(1.4f * x);
+}
+
+/* Noise voice samples rendered ahead of each block kernel pass. */
+#define OSC_NOISE_CHUNK 64
+
+/* One main-oscillator cycle in accumulator steps (2^30). */
+#define OSC_PHASE_ONE 1073741824.0f
+#define OSC_PHASE_ONE_U 0x40000000u
+/* Main phase as float in [0, 1): 24 bits below the two divider bits. */
+#define OSC_PHASE_TO_FLOAT(acc) ((float)(int32_t)(((acc) << 2) >> 8) * (1.0f / 16777216.0f))
+
+/* Sub waveform for sub_mode: the accumulator bits that make it low, and its
+   high level.  Bit 30 is the /2 square, bit 31 the /4 square, and both clear
+   the 25% /4 pulse. */
+static inline void sub_shape(int sub_mode, uint32_t *bits, float *hi) {
+    if (sub_mode == 1) {
+        *bits = 0x80000000u;
+        *hi = 0.94f;
+    } else if (sub_mode == 2) {
+        *bits = 0xC0000000u;
+        *hi = 1.0f;
+    } else {
+        *bits = 0x40000000u;
+        *hi = 0.94f;
+    }
+}
+
+static inline uint32_t phase_inc(const sh101_osc_t *osc, float freq_hz) {
+    return (uint32_t)(int32_t)clampf(freq_hz * osc->inc_per_hz, 0.0f, 0.45f * OSC_PHASE_ONE);
+}
+
+static inline float sub_level(uint32_t acc, uint32_t bits, float hi) {
+    return (acc & bits) ? -1.0f : hi;
+}
+
+/* Two-sample PolyBLEP for a step at phase wrap, split into the weight of the
+   step just taken (t < dt) and of the upcoming one (t > 1 - dt).  A step of
+   height h is corrected by h/2 * (before - after).  idt = 1/dt. */
+static inline void blep_weights(float t, float idt, float *after, float *before) {
+    float a = 1.0f - t * idt;
+    float b = (t - 1.0f) * idt + 1.0f;
+    *after = (a > 0.0f) ? a * a : 0.0f;
+    *before = (b > 0.0f) ? b * b : 0.0f;
 }
 
 void sh101_osc_init(sh101_osc_t *osc, float sample_rate, uint32_t seed) {
     osc->sample_rate = sample_rate;
-    osc->phase = 0.0f;
-    osc->sub_phase = 0.0f;
-    osc->sub2_phase = 0.0f;
+    osc->inc_per_hz = OSC_PHASE_ONE / sample_rate;
+    osc->phase = 0u;
+    osc->band_limited = 0;
+    osc->adaa = 0;
     osc->noise_lp = 0.0f;
-    osc->noise_state = seed ? seed : 0x12345678u;
+    osc->noise_lp_a = sh101_noise_lp_coef(sample_rate);
+    sh101_noise_seed(&osc->noise, seed ? seed : 0x12345678u);
+    osc->sat_prev = 0.0f;
+    sh101_adaa_init();
 }
 
 float sh101_white_noise(sh101_osc_t *osc) {
-    osc->noise_state = osc->noise_state * 1664525u + 1013904223u;
-    return ((float)((int32_t)osc->noise_state) / 2147483648.0f);
+    return sh101_noise_next(&osc->noise);
+}
+
+/* Returns the mixer output before soft_sat(); `noise` is this sample of the
+   noise voice (see sh101_noise_colored_block). */
+static inline float osc_tick(sh101_osc_t *osc,
+                             float freq_hz,
+                             float pwm,
+                             float saw_mix,
+                             float pulse_mix,
+                             float sub_mix,
+                             float noise_mix,
+                             int sub_mode,
+                             float noise) {
+    uint32_t sub_bits;
+    float sub_hi;
+    sub_shape(sub_mode, &sub_bits, &sub_hi);
+
+    uint32_t inc = phase_inc(osc, freq_hz);
+    uint32_t acc = osc->phase + inc;
+    osc->phase = acc;
+    float phase = OSC_PHASE_TO_FLOAT(acc);
+
+    pwm = clampf(pwm, 0.05f, 0.95f);
+
+    float saw = 2.0f * phase - 1.0f;
+
+    /* Small asymmetries keep pulse/sub from sounding sterile. */
+    float pulse;
+    float sub = sub_level(acc, sub_bits, sub_hi);
+    if (osc->band_limited) {
+        /* Pulse is the difference of two band-limited saws a duty cycle
+           apart; every sub edge falls on a main-phase wrap, so the subs
+           reuse the saw's BLEP weights with their own step heights. */
+        float idt = OSC_PHASE_ONE / (float)(inc ? inc : 1u);
+        float after, before, after2, before2;
+        float t2 = phase - pwm;
+        if (t2 < 0.0f) t2 += 1.0f;
+        blep_weights(phase, idt, &after, &before);
+        blep_weights(t2, idt, &after2, &before2);
+        saw -= before - after;
+        {
+            float saw2 = 2.0f * t2 - 1.0f - (before2 - after2);
+            pulse = -0.95f + 1.95f * (pwm - 0.5f * (saw - saw2));
+        }
+        {
+            float h_after = sub - sub_level(acc - OSC_PHASE_ONE_U, sub_bits, sub_hi);
+            float h_before = sub_level(acc + OSC_PHASE_ONE_U, sub_bits, sub_hi) - sub;
+            sub += 0.5f * (h_before * before - h_after * after);
+        }
+    } else {
+        pulse = (phase < pwm) ? 1.0f : -0.95f;
+    }
+
+    {
+        float mix = saw_mix * saw + pulse_mix * pulse + sub_mix * sub + noise_mix * noise;
+
+        /* Mixer headroom; soft clipping is applied by the callers. */
+        return mix * 0.42f;
+    }
 }
 
 float sh101_osc_render(sh101_osc_t *osc,
@@ -35,41 +153,424 @@ float sh101_osc_render(sh101_osc_t *osc,
                        float noise_mix,
                        int sub_mode,
                        float noise_color) {
-    float inc = freq_hz / osc->sample_rate;
-    if (inc < 0.0f) inc = 0.0f;
-    if (inc > 0.45f) inc = 0.45f;
+    /* Slightly colored noise sits better for SH-style transients than pure
+       white noise.  A muted noise voice does not draw from the stream. */
+    float noise = 0.0f;
+    if (noise_mix != 0.0f) {
+        noise = sh101_noise_colored_next(&osc->noise, &osc->noise_lp, osc->noise_lp_a, clampf(noise_color, 0.0f, 1.0f));
+    }
+    /* Soft clipping helps preserve the "pushed mixer" character. */
+    return soft_sat(osc, osc_tick(osc, freq_hz, pwm, saw_mix, pulse_mix, sub_mix, noise_mix, sub_mode, noise));
+}
 
-    osc->phase += inc;
-    if (osc->phase >= 1.0f) osc->phase -= 1.0f;
+/* SIMD block kernels.  Four samples are produced per iteration: the
+   accumulator advances by an integer prefix sum of the increments, so
+   phases and edges are bit-identical to osc_tick().  The noise voice comes
+   in pre-rendered from sh101_noise_colored_block.
 
-    osc->sub_phase += inc * 0.5f;
-    if (osc->sub_phase >= 1.0f) osc->sub_phase -= 1.0f;
-    osc->sub2_phase += inc * 0.25f;
-    if (osc->sub2_phase >= 1.0f) osc->sub2_phase -= 1.0f;
+   The kernel bodies are force-inlined so that each ISA wrapper below
+   compiles its own copy for its target. */
 
-    pwm = clampf(pwm, 0.05f, 0.95f);
-    noise_color = clampf(noise_color, 0.0f, 1.0f);
+#if defined(__GNUC__)
+#define OSC_INLINE static inline __attribute__((always_inline))
+#else
+#define OSC_INLINE static inline
+#endif
 
-    float saw = 2.0f * osc->phase - 1.0f;
+#if defined(SH101_FASTMATH_NEON)
 
-    /* Small asymmetries keep pulse/sub from sounding sterile. */
-    float pulse = (osc->phase < pwm) ? 1.0f : -0.95f;
-    float sub1_square = (osc->sub_phase < 0.5f) ? 0.94f : -1.0f;
-    float sub2_square = (osc->sub2_phase < 0.5f) ? 0.94f : -1.0f;
-    float sub2_pulse = (osc->sub2_phase < 0.25f) ? 1.0f : -1.0f;
-    float sub = sub1_square;
-    if (sub_mode == 1) sub = sub2_square;
-    else if (sub_mode == 2) sub = sub2_pulse;
-
-    /* Slightly colored noise sits better for SH-style transients than pure white noise. */
-    float white = sh101_white_noise(osc);
-    osc->noise_lp += 0.085f * (white - osc->noise_lp);
-    {
-        float colored = 0.72f * osc->noise_lp + 0.28f * white;
-        float noise = colored + (white - colored) * noise_color;
-        float mix = saw_mix * saw + pulse_mix * pulse + sub_mix * sub + noise_mix * noise;
+OSC_INLINE void osc_blep_x4(float32x4_t t, float32x4_t idt, float32x4_t *after, float32x4_t *before) {
+    float32x4_t z = vdupq_n_f32(0.0f);
+    float32x4_t one = vdupq_n_f32(1.0f);
+    float32x4_t a = vmaxq_f32(vsubq_f32(one, vmulq_f32(t, idt)), z);
+    float32x4_t b = vmaxq_f32(vaddq_f32(vmulq_f32(vsubq_f32(t, one), idt), one), z);
+    *after = vmulq_f32(a, a);
+    *before = vmulq_f32(b, b);
+}
+
+OSC_INLINE int osc_render_x4_impl(sh101_osc_t *osc, const float *freq_hz, const float *pwm,
+                                     float saw_mix, float pulse_mix, float sub_mix, float noise_mix,
+                                     int sub_mode, const float *noise, float *out, int frames,
+                                     const int band_limited) {
+    uint32_t sub_bits_s;
+    float sub_hi_s;
+    int n4 = frames & ~3;
+    if (n4 == 0) return 0;
+    sub_shape(sub_mode, &sub_bits_s, &sub_hi_s);
 
-        /* Mixer headroom + soft clipping helps preserve the "pushed mixer" character. */
-        return soft_sat(mix * 0.42f);
+    uint32x4_t zero_u = vdupq_n_u32(0u);
+    float32x4_t z = vdupq_n_f32(0.0f);
+    uint32x4_t acc = vdupq_n_u32(osc->phase);
+    uint32x4_t sub_bits = vdupq_n_u32(sub_bits_s);
+    float32x4_t sub_hi = vdupq_n_f32(sub_hi_s);
+    float32x4_t sub_lo = vdupq_n_f32(-1.0f);
+    float32x4_t pulse_hi = vdupq_n_f32(1.0f);
+    float32x4_t pulse_lo = vdupq_n_f32(-0.95f);
+    float32x4_t one = vdupq_n_f32(1.0f);
+    uint32x4_t one_u = vdupq_n_u32(OSC_PHASE_ONE_U);
+
+    for (int i = 0; i < n4; i += 4) {
+        float32x4_t incf = vmulq_n_f32(vld1q_f32(freq_hz + i), osc->inc_per_hz);
+        incf = vminq_f32(vmaxq_f32(incf, z), vdupq_n_f32(0.45f * OSC_PHASE_ONE));
+        uint32x4_t inc0 = vreinterpretq_u32_s32(vcvtq_s32_f32(incf));
+        uint32x4_t inc = vaddq_u32(inc0, vextq_u32(zero_u, inc0, 3));
+        inc = vaddq_u32(inc, vextq_u32(zero_u, inc, 2));
+        uint32x4_t p = vaddq_u32(acc, inc);
+        acc = vdupq_laneq_u32(p, 3);
+
+        float32x4_t phase = vmulq_n_f32(vcvtq_f32_s32(vreinterpretq_s32_u32(vshrq_n_u32(vshlq_n_u32(p, 2), 8))),
+                                        1.0f / 16777216.0f);
+        float32x4_t pw = vminq_f32(vmaxq_f32(vld1q_f32(pwm + i), vdupq_n_f32(0.05f)), vdupq_n_f32(0.95f));
+        float32x4_t saw = vsubq_f32(vmulq_n_f32(phase, 2.0f), vdupq_n_f32(1.0f));
+        float32x4_t pulse;
+        float32x4_t sub = vbslq_f32(vtstq_u32(p, sub_bits), sub_lo, sub_hi);
+        if (band_limited) {
+            float32x4_t idt = vdivq_f32(vdupq_n_f32(OSC_PHASE_ONE),
+                                        vmaxq_f32(vcvtq_f32_u32(inc0), one));
+            float32x4_t after, before, after2, before2;
+            float32x4_t t2 = vsubq_f32(phase, pw);
+            t2 = vaddq_f32(t2, vreinterpretq_f32_u32(vandq_u32(vcltq_f32(t2, z), vreinterpretq_u32_f32(one))));
+            osc_blep_x4(phase, idt, &after, &before);
+            osc_blep_x4(t2, idt, &after2, &before2);
+            saw = vsubq_f32(saw, vsubq_f32(before, after));
+            {
+                float32x4_t saw2 = vsubq_f32(vsubq_f32(vmulq_n_f32(t2, 2.0f), one), vsubq_f32(before2, after2));
+                float32x4_t sq = vsubq_f32(pw, vmulq_n_f32(vsubq_f32(saw, saw2), 0.5f));
+                pulse = vaddq_f32(pulse_lo, vmulq_n_f32(sq, 1.95f));
+            }
+            {
+                float32x4_t sub_prev = vbslq_f32(vtstq_u32(vsubq_u32(p, one_u), sub_bits), sub_lo, sub_hi);
+                float32x4_t sub_next = vbslq_f32(vtstq_u32(vaddq_u32(p, one_u), sub_bits), sub_lo, sub_hi);
+                float32x4_t h_after = vsubq_f32(sub, sub_prev);
+                float32x4_t h_before = vsubq_f32(sub_next, sub);
+                sub = vaddq_f32(sub, vmulq_n_f32(vsubq_f32(vmulq_f32(h_before, before), vmulq_f32(h_after, after)), 0.5f));
+            }
+        } else {
+            pulse = vbslq_f32(vcltq_f32(phase, pw), pulse_hi, pulse_lo);
+        }
+
+        float32x4_t mix = vmulq_n_f32(saw, saw_mix);
+        mix = vmlaq_n_f32(mix, pulse, pulse_mix);
+        mix = vmlaq_n_f32(mix, sub, sub_mix);
+        mix = vmlaq_n_f32(mix, vld1q_f32(noise + i), noise_mix);
+        vst1q_f32(out + i, vmulq_n_f32(mix, 0.42f));
+    }
+
+    osc->phase = vgetq_lane_u32(acc, 0);
+    return n4;
+}
+
+#elif defined(SH101_FASTMATH_SSE2)
+
+OSC_INLINE __m128 osc_select_x4(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+OSC_INLINE __m128 osc_sub_high_x4(__m128i acc, __m128i bits) {
+    return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(acc, bits), _mm_setzero_si128()));
+}
+
+OSC_INLINE void osc_blep_x4(__m128 t, __m128 idt, __m128 *after, __m128 *before) {
+    __m128 z = _mm_setzero_ps();
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 a = _mm_max_ps(_mm_sub_ps(one, _mm_mul_ps(t, idt)), z);
+    __m128 b = _mm_max_ps(_mm_add_ps(_mm_mul_ps(_mm_sub_ps(t, one), idt), one), z);
+    *after = _mm_mul_ps(a, a);
+    *before = _mm_mul_ps(b, b);
+}
+
+OSC_INLINE int osc_render_x4_impl(sh101_osc_t *osc, const float *freq_hz, const float *pwm,
+                                     float saw_mix, float pulse_mix, float sub_mix, float noise_mix,
+                                     int sub_mode, const float *noise, float *out, int frames,
+                                     const int band_limited) {
+    uint32_t sub_bits_s;
+    float sub_hi_s;
+    int n4 = frames & ~3;
+    if (n4 == 0) return 0;
+    sub_shape(sub_mode, &sub_bits_s, &sub_hi_s);
+
+    __m128i acc = _mm_set1_epi32((int)osc->phase);
+    __m128i sub_bits = _mm_set1_epi32((int)sub_bits_s);
+    __m128 sub_hi = _mm_set1_ps(sub_hi_s);
+    __m128 sub_lo = _mm_set1_ps(-1.0f);
+    __m128 pulse_hi = _mm_set1_ps(1.0f);
+    __m128 pulse_lo = _mm_set1_ps(-0.95f);
+    __m128 inc_per_hz = _mm_set1_ps(osc->inc_per_hz);
+    __m128 inc_max = _mm_set1_ps(0.45f * OSC_PHASE_ONE);
+    __m128 phase_scale = _mm_set1_ps(1.0f / 16777216.0f);
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128i one_u = _mm_set1_epi32((int)OSC_PHASE_ONE_U);
+
+    for (int i = 0; i < n4; i += 4) {
+        __m128 incf = _mm_mul_ps(_mm_loadu_ps(freq_hz + i), inc_per_hz);
+        incf = _mm_min_ps(_mm_max_ps(incf, _mm_setzero_ps()), inc_max);
+        __m128i inc0 = _mm_cvttps_epi32(incf);
+        __m128i inc = _mm_add_epi32(inc0, _mm_slli_si128(inc0, 4));
+        inc = _mm_add_epi32(inc, _mm_slli_si128(inc, 8));
+        __m128i p = _mm_add_epi32(acc, inc);
+        acc = _mm_shuffle_epi32(p, _MM_SHUFFLE(3, 3, 3, 3));
+
+        __m128 phase = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(_mm_slli_epi32(p, 2), 8)), phase_scale);
+        __m128 pw = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(pwm + i), _mm_set1_ps(0.05f)), _mm_set1_ps(0.95f));
+        __m128 saw = _mm_sub_ps(_mm_mul_ps(phase, _mm_set1_ps(2.0f)), _mm_set1_ps(1.0f));
+        __m128 pulse;
+        __m128 sub = osc_select_x4(osc_sub_high_x4(p, sub_bits), sub_hi, sub_lo);
+        if (band_limited) {
+            __m128 idt = _mm_div_ps(_mm_set1_ps(OSC_PHASE_ONE), _mm_max_ps(_mm_cvtepi32_ps(inc0), one));
+            __m128 after, before, after2, before2;
+            __m128 t2 = _mm_sub_ps(phase, pw);
+            t2 = _mm_add_ps(t2, _mm_and_ps(_mm_cmplt_ps(t2, _mm_setzero_ps()), one));
+            osc_blep_x4(phase, idt, &after, &before);
+            osc_blep_x4(t2, idt, &after2, &before2);
+            saw = _mm_sub_ps(saw, _mm_sub_ps(before, after));
+            {
+                __m128 saw2 = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(t2, _mm_set1_ps(2.0f)), one),
+                                         _mm_sub_ps(before2, after2));
+                __m128 sq = _mm_sub_ps(pw, _mm_mul_ps(_mm_sub_ps(saw, saw2), _mm_set1_ps(0.5f)));
+                pulse = _mm_add_ps(pulse_lo, _mm_mul_ps(sq, _mm_set1_ps(1.95f)));
+            }
+            {
+                __m128 sub_prev = osc_select_x4(osc_sub_high_x4(_mm_sub_epi32(p, one_u), sub_bits), sub_hi, sub_lo);
+                __m128 sub_next = osc_select_x4(osc_sub_high_x4(_mm_add_epi32(p, one_u), sub_bits), sub_hi, sub_lo);
+                __m128 h_after = _mm_sub_ps(sub, sub_prev);
+                __m128 h_before = _mm_sub_ps(sub_next, sub);
+                sub = _mm_add_ps(sub, _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(h_before, before), _mm_mul_ps(h_after, after)),
+                                                 _mm_set1_ps(0.5f)));
+            }
+        } else {
+            pulse = osc_select_x4(_mm_cmplt_ps(phase, pw), pulse_hi, pulse_lo);
+        }
+
+        __m128 mix = _mm_mul_ps(saw, _mm_set1_ps(saw_mix));
+        mix = _mm_add_ps(mix, _mm_mul_ps(pulse, _mm_set1_ps(pulse_mix)));
+        mix = _mm_add_ps(mix, _mm_mul_ps(sub, _mm_set1_ps(sub_mix)));
+        mix = _mm_add_ps(mix, _mm_mul_ps(_mm_loadu_ps(noise + i), _mm_set1_ps(noise_mix)));
+        _mm_storeu_ps(out + i, _mm_mul_ps(mix, _mm_set1_ps(0.42f)));
+    }
+
+    osc->phase = (uint32_t)_mm_cvtsi128_si32(acc);
+    return n4;
+}
+
+#endif
+
+#if defined(OSC_X86_VARIANTS)
+
+/* AVX2: the SSE2 kernel eight lanes wide.  The prefix sum runs within each
+   128-bit half, then the low half's total is carried into the high half. */
+
+__attribute__((target("avx2")))
+static inline __m256 osc_select_x8(__m256 mask, __m256 a, __m256 b) {
+    return _mm256_blendv_ps(b, a, mask);
+}
+
+__attribute__((target("avx2")))
+static inline __m256 osc_sub_high_x8(__m256i acc, __m256i bits) {
+    return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(acc, bits), _mm256_setzero_si256()));
+}
+
+__attribute__((target("avx2")))
+static inline void osc_blep_x8(__m256 t, __m256 idt, __m256 *after, __m256 *before) {
+    __m256 z = _mm256_setzero_ps();
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 a = _mm256_max_ps(_mm256_sub_ps(one, _mm256_mul_ps(t, idt)), z);
+    __m256 b = _mm256_max_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(t, one), idt), one), z);
+    *after = _mm256_mul_ps(a, a);
+    *before = _mm256_mul_ps(b, b);
+}
+
+__attribute__((target("avx2")))
+static inline int osc_render_x8_impl(sh101_osc_t *osc, const float *freq_hz, const float *pwm,
+                                     float saw_mix, float pulse_mix, float sub_mix, float noise_mix,
+                                     int sub_mode, const float *noise, float *out, int frames,
+                                     const int band_limited) {
+    uint32_t sub_bits_s;
+    float sub_hi_s;
+    int n8 = frames & ~7;
+    if (n8 == 0) return 0;
+    sub_shape(sub_mode, &sub_bits_s, &sub_hi_s);
+
+    __m256i acc = _mm256_set1_epi32((int)osc->phase);
+    __m256i sub_bits = _mm256_set1_epi32((int)sub_bits_s);
+    __m256i last = _mm256_set1_epi32(7);
+    __m256 sub_hi = _mm256_set1_ps(sub_hi_s);
+    __m256 sub_lo = _mm256_set1_ps(-1.0f);
+    __m256 pulse_hi = _mm256_set1_ps(1.0f);
+    __m256 pulse_lo = _mm256_set1_ps(-0.95f);
+    __m256 inc_per_hz = _mm256_set1_ps(osc->inc_per_hz);
+    __m256 inc_max = _mm256_set1_ps(0.45f * OSC_PHASE_ONE);
+    __m256 phase_scale = _mm256_set1_ps(1.0f / 16777216.0f);
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256i one_u = _mm256_set1_epi32((int)OSC_PHASE_ONE_U);
+
+    for (int i = 0; i < n8; i += 8) {
+        __m256 incf = _mm256_mul_ps(_mm256_loadu_ps(freq_hz + i), inc_per_hz);
+        incf = _mm256_min_ps(_mm256_max_ps(incf, _mm256_setzero_ps()), inc_max);
+        __m256i inc0 = _mm256_cvttps_epi32(incf);
+        __m256i inc = _mm256_add_epi32(inc0, _mm256_slli_si256(inc0, 4));
+        inc = _mm256_add_epi32(inc, _mm256_slli_si256(inc, 8));
+        inc = _mm256_add_epi32(inc, _mm256_shuffle_epi32(_mm256_permute2x128_si256(inc, inc, 0x08),
+                                                         _MM_SHUFFLE(3, 3, 3, 3)));
+        __m256i p = _mm256_add_epi32(acc, inc);
+        acc = _mm256_permutevar8x32_epi32(p, last);
+
+        __m256 phase = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(_mm256_slli_epi32(p, 2), 8)), phase_scale);
+        __m256 pw = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(pwm + i), _mm256_set1_ps(0.05f)),
+                                  _mm256_set1_ps(0.95f));
+        __m256 saw = _mm256_sub_ps(_mm256_mul_ps(phase, _mm256_set1_ps(2.0f)), one);
+        __m256 pulse;
+        __m256 sub = osc_select_x8(osc_sub_high_x8(p, sub_bits), sub_hi, sub_lo);
+        if (band_limited) {
+            __m256 idt = _mm256_div_ps(_mm256_set1_ps(OSC_PHASE_ONE), _mm256_max_ps(_mm256_cvtepi32_ps(inc0), one));
+            __m256 after, before, after2, before2;
+            __m256 t2 = _mm256_sub_ps(phase, pw);
+            t2 = _mm256_add_ps(t2, _mm256_and_ps(_mm256_cmp_ps(t2, _mm256_setzero_ps(), _CMP_LT_OQ), one));
+            osc_blep_x8(phase, idt, &after, &before);
+            osc_blep_x8(t2, idt, &after2, &before2);
+            saw = _mm256_sub_ps(saw, _mm256_sub_ps(before, after));
+            {
+                __m256 saw2 = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(t2, _mm256_set1_ps(2.0f)), one),
+                                            _mm256_sub_ps(before2, after2));
+                __m256 sq = _mm256_sub_ps(pw, _mm256_mul_ps(_mm256_sub_ps(saw, saw2), _mm256_set1_ps(0.5f)));
+                pulse = _mm256_add_ps(pulse_lo, _mm256_mul_ps(sq, _mm256_set1_ps(1.95f)));
+            }
+            {
+                __m256 sub_prev = osc_select_x8(osc_sub_high_x8(_mm256_sub_epi32(p, one_u), sub_bits), sub_hi, sub_lo);
+                __m256 sub_next = osc_select_x8(osc_sub_high_x8(_mm256_add_epi32(p, one_u), sub_bits), sub_hi, sub_lo);
+                __m256 h_after = _mm256_sub_ps(sub, sub_prev);
+                __m256 h_before = _mm256_sub_ps(sub_next, sub);
+                sub = _mm256_add_ps(sub, _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(h_before, before),
+                                                                     _mm256_mul_ps(h_after, after)),
+                                                       _mm256_set1_ps(0.5f)));
+            }
+        } else {
+            pulse = osc_select_x8(_mm256_cmp_ps(phase, pw, _CMP_LT_OQ), pulse_hi, pulse_lo);
+        }
+
+        __m256 mix = _mm256_mul_ps(saw, _mm256_set1_ps(saw_mix));
+        mix = _mm256_add_ps(mix, _mm256_mul_ps(pulse, _mm256_set1_ps(pulse_mix)));
+        mix = _mm256_add_ps(mix, _mm256_mul_ps(sub, _mm256_set1_ps(sub_mix)));
+        mix = _mm256_add_ps(mix, _mm256_mul_ps(_mm256_loadu_ps(noise + i), _mm256_set1_ps(noise_mix)));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(mix, _mm256_set1_ps(0.42f)));
+    }
+
+    osc->phase = (uint32_t)_mm_cvtsi128_si32(_mm256_castsi256_si128(acc));
+    return n8;
+}
+
+#endif
+
+/* Per-ISA entry points: render the largest multiple of the vector width
+   and return the count rendered; the caller finishes with osc_tick(). */
+typedef int (*osc_simd_fn)(sh101_osc_t *osc, const float *freq_hz, const float *pwm,
+                           float saw_mix, float pulse_mix, float sub_mix, float noise_mix,
+                           int sub_mode, const float *noise, float *out, int frames);
+
+static int osc_render_scalar(sh101_osc_t *osc, const float *freq_hz, const float *pwm,
+                             float saw_mix, float pulse_mix, float sub_mix, float noise_mix,
+                             int sub_mode, const float *noise, float *out, int frames) {
+    (void)osc; (void)freq_hz; (void)pwm; (void)saw_mix; (void)pulse_mix; (void)sub_mix;
+    (void)noise_mix; (void)sub_mode; (void)noise; (void)out; (void)frames;
+    return 0;
+}
+
+#define OSC_SIMD_ENTRY(name, attr, impl)                                                       \
+    attr static int name(sh101_osc_t *osc, const float *freq_hz, const float *pwm,              \
+                         float saw_mix, float pulse_mix, float sub_mix, float noise_mix,        \
+                         int sub_mode, const float *noise, float *out, int frames) {            \
+        if (osc->band_limited) {                                                               \
+            return impl(osc, freq_hz, pwm, saw_mix, pulse_mix, sub_mix, noise_mix,             \
+                        sub_mode, noise, out, frames, 1);                                      \
+        }                                                                                      \
+        return impl(osc, freq_hz, pwm, saw_mix, pulse_mix, sub_mix, noise_mix,                 \
+                    sub_mode, noise, out, frames, 0);                                          \
+    }
+
+#if defined(SH101_FASTMATH_NEON)
+OSC_SIMD_ENTRY(osc_render_neon, , osc_render_x4_impl)
+#define OSC_BASELINE_FN osc_render_neon
+#define OSC_BASELINE_ISA SH101_ISA_NEON
+#elif defined(SH101_FASTMATH_SSE2)
+OSC_SIMD_ENTRY(osc_render_sse2, , osc_render_x4_impl)
+#define OSC_BASELINE_FN osc_render_sse2
+#define OSC_BASELINE_ISA SH101_ISA_SSE2
+#else
+#define OSC_BASELINE_FN osc_render_scalar
+#define OSC_BASELINE_ISA SH101_ISA_SCALAR
+#endif
+
+#if defined(OSC_X86_VARIANTS)
+OSC_SIMD_ENTRY(osc_render_avx2, __attribute__((target("avx2"))), osc_render_x8_impl)
+#endif
+
+#undef OSC_SIMD_ENTRY
+
+/* Process-wide: chosen once from sh101_osc_set_isa at plugin init. */
+static osc_simd_fn g_osc_simd = OSC_BASELINE_FN;
+static sh101_isa_t g_osc_isa = OSC_BASELINE_ISA;
+
+sh101_isa_t sh101_osc_set_isa(sh101_isa_t isa) {
+    osc_simd_fn fn = NULL;
+    if (!sh101_cpu_supports(isa)) return g_osc_isa;
+    switch (isa) {
+    case SH101_ISA_SCALAR: fn = osc_render_scalar; break;
+#if defined(SH101_FASTMATH_NEON)
+    case SH101_ISA_NEON: fn = osc_render_neon; break;
+#endif
+#if defined(SH101_FASTMATH_SSE2)
+    case SH101_ISA_SSE2: fn = osc_render_sse2; break;
+#endif
+#if defined(OSC_X86_VARIANTS)
+    case SH101_ISA_AVX2: fn = osc_render_avx2; break;
+#endif
+    default: break;
+    }
+    if (fn) {
+        g_osc_simd = fn;
+        g_osc_isa = isa;
+    }
+    return g_osc_isa;
+}
+
+sh101_isa_t sh101_osc_isa(void) {
+    return g_osc_isa;
+}
+
+void sh101_osc_render_block(sh101_osc_t *osc,
+                            const float *freq_hz,
+                            const float *pwm,
+                            float saw_mix,
+                            float pulse_mix,
+                            float sub_mix,
+                            float noise_mix,
+                            int sub_mode,
+                            float noise_color,
+                            float *out,
+                            int frames) {
+    float noise[OSC_NOISE_CHUNK];
+    noise_color = clampf(noise_color, 0.0f, 1.0f);
+    for (int done = 0; done < frames; ) {
+        int n = frames - done;
+        int i = 0;
+        if (n > OSC_NOISE_CHUNK) n = OSC_NOISE_CHUNK;
+        if (noise_mix != 0.0f) {
+            sh101_noise_colored_block(&osc->noise, &osc->noise_lp, osc->noise_lp_a, noise_color, noise, n);
+        } else {
+            memset(noise, 0, (size_t)n * sizeof(float));
+        }
+        i = g_osc_simd(osc, freq_hz + done, pwm + done, saw_mix, pulse_mix, sub_mix, noise_mix, sub_mode,
+                       noise, out + done, n);
+        for (; i < n; ++i) {
+            out[done + i] = osc_tick(osc, freq_hz[done + i], pwm[done + i], saw_mix, pulse_mix, sub_mix, noise_mix,
+                                     sub_mode, noise[i]);
+        }
+        done += n;
+    }
+    /* soft_sat() over the whole block in one pass. */
+    if (osc->adaa) {
+        sh101_adaa_tanh_block(&osc->sat_prev, out, out, 1.4f, frames);
+    } else if (frames > 0) {
+        osc->sat_prev = 1.4f * out[frames - 1];
+        sh101_fast_tanhf_block(out, out, 1.4f, frames);
     }
 }
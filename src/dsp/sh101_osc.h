@@ -3,17 +3,29 @@
 
 #include <stdint.h>
 
+#include "sh101_cpu.h"
+#include "sh101_noise.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 typedef struct {
     float sample_rate;
-    float phase;
-    float sub_phase;
-    float sub2_phase;
-    float noise_lp;
-    uint32_t noise_state;
+    float inc_per_hz;      /* accumulator steps per Hz of oscillator pitch */
+    /* Divider chain in one counter: the low 30 bits are the main phase and
+       the top two bits count main cycles, giving the /2 and /4 sub phases. */
+    uint32_t phase;
+    /* Nonzero: PolyBLEP-corrected saw, pulse and sub instead of naive edges. */
+    int band_limited;
+    sh101_noise_t noise;
+    float noise_lp;  /* coloured-noise one-pole state */
+    float noise_lp_a; /* its coefficient, from sh101_noise_lp_coef */
+    /* Nonzero: antiderivative anti-aliased mixer soft clip.  ADAA adds half
+       a sample of delay and a gentle high-frequency rolloff, so the plain
+       tanh stays the calibrated default. */
+    int adaa;
+    float sat_prev; /* previous soft-clip input, for ADAA */
 } sh101_osc_t;
 
 void sh101_osc_init(sh101_osc_t *osc, float sample_rate, uint32_t seed);
@@ -27,6 +39,23 @@ float sh101_osc_render(sh101_osc_t *osc,
                        float noise_mix,
                        int sub_mode,
                        float noise_color);
+/* Renders `frames` samples with per-sample frequency and pulse width. */
+void sh101_osc_render_block(sh101_osc_t *osc,
+                            const float *freq_hz,
+                            const float *pwm,
+                            float saw_mix,
+                            float pulse_mix,
+                            float sub_mix,
+                            float noise_mix,
+                            int sub_mode,
+                            float noise_color,
+                            float *out,
+                            int frames);
+/* Selects the block kernel for `isa` for every oscillator in the process.
+   Levels the CPU or build lacks leave the current kernel in place.
+   Returns the level in use; the default is the build baseline. */
+sh101_isa_t sh101_osc_set_isa(sh101_isa_t isa);
+sh101_isa_t sh101_osc_isa(void);
 
 #ifdef __cplusplus
 }
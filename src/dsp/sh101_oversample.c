@@ -0,0 +1,123 @@
+#include "sh101_oversample.h"
+
+#include "sh101_fastmath.h"
+
+#include <string.h>
+
+/* Base-rate frames per internal pass; bounds the stack work buffers. */
+#define OS_BLOCK 32
+
+/* Odd half-band taps h[+-(2k+1)], Kaiser-windowed sinc (beta 7 and 6),
+   normalized for unity DC gain. */
+#define HB_A_TAPS 12
+static const float g_hb_a[HB_A_TAPS] = {
+    3.165601023e-01f, -1.008596125e-01f, 5.523949789e-02f, -3.433166774e-02f,
+    2.207986149e-02f, -1.413085820e-02f, 8.787184396e-03f, -5.204280909e-03f,
+    2.870759772e-03f, -1.428309265e-03f, 6.044143708e-04f, -1.870915499e-04f,
+};
+
+#define HB_B_TAPS 4
+static const float g_hb_b[HB_B_TAPS] = {
+    3.048446752e-01f, -7.125062539e-02f, 1.946197474e-02f, -3.056024531e-03f,
+};
+
+/* acc[m] = sum_k h[k] * (x[m - k] + x[m + 1 + k]) for m in [0, n). */
+static void hb_fir(const float *x, const float *h, int taps, float *acc, int n) {
+    int m = 0;
+#if defined(SH101_FASTMATH_SIMD)
+    for (; m + 4 <= n; m += 4) {
+        sh101_f32x4 sum = SH101_F32X4_SPLAT(0.0f);
+        for (int k = 0; k < taps; ++k) {
+            sh101_f32x4 pair = SH101_F32X4_ADD(SH101_F32X4_LOAD(x + m - k), SH101_F32X4_LOAD(x + m + 1 + k));
+            sum = SH101_F32X4_ADD(sum, SH101_F32X4_MUL(pair, SH101_F32X4_SPLAT(h[k])));
+        }
+        SH101_F32X4_STORE(acc + m, sum);
+    }
+#endif
+    for (; m < n; ++m) {
+        float sum = 0.0f;
+        for (int k = 0; k < taps; ++k) sum += h[k] * (x[m - k] + x[m + 1 + k]);
+        acc[m] = sum;
+    }
+}
+
+/* 1:2 interpolation of n <= 2 * OS_BLOCK samples.  Odd outputs land on
+   the zero-stuffed inputs and reduce to the centre tap; even outputs are
+   the symmetric FIR, scaled by 2 for the stuffed zeros. */
+static void hb_up(sh101_halfband_t *st, const float *h, int taps, const float *in, float *out, int n) {
+    float w[SH101_OS_HIST + 2 * OS_BLOCK];
+    float acc[2 * OS_BLOCK];
+    const float *x = w + SH101_OS_HIST - taps;
+
+    memcpy(w, st->up, sizeof(st->up));
+    memcpy(w + SH101_OS_HIST, in, (size_t)n * sizeof(float));
+    hb_fir(x, h, taps, acc, n);
+    for (int m = 0; m < n; ++m) {
+        out[2 * m] = 2.0f * acc[m];
+        out[2 * m + 1] = x[m + 1];
+    }
+    memcpy(st->up, w + n, sizeof(st->up));
+}
+
+/* 2:1 decimation into n <= 2 * OS_BLOCK samples: the even phase runs the
+   symmetric FIR, the odd phase only meets the centre tap. */
+static void hb_down(sh101_halfband_t *st, const float *h, int taps, const float *in, float *out, int n) {
+    float e[SH101_OS_HIST + 2 * OS_BLOCK];
+    float o[SH101_OS_HIST + 2 * OS_BLOCK];
+    const float *xe = e + SH101_OS_HIST - taps;
+    const float *xo = o + SH101_OS_HIST - taps;
+
+    memcpy(e, st->dn_even, sizeof(st->dn_even));
+    memcpy(o, st->dn_odd, sizeof(st->dn_odd));
+    for (int p = 0; p < n; ++p) {
+        e[SH101_OS_HIST + p] = in[2 * p];
+        o[SH101_OS_HIST + p] = in[2 * p + 1];
+    }
+    hb_fir(xe, h, taps, out, n);
+    for (int m = 0; m < n; ++m) out[m] += 0.5f * xo[m];
+    memcpy(st->dn_even, e + n, sizeof(st->dn_even));
+    memcpy(st->dn_odd, o + n, sizeof(st->dn_odd));
+}
+
+void sh101_oversampler_init(sh101_oversampler_t *os, int factor) {
+    memset(os, 0, sizeof(*os));
+    os->factor = factor >= 4 ? 4 : (factor >= 2 ? 2 : 1);
+}
+
+void sh101_oversampler_up(sh101_oversampler_t *os, const float *in, float *out, int frames) {
+    float mid[2 * OS_BLOCK];
+    if (os->factor == 1) {
+        if (out != in) memmove(out, in, (size_t)frames * sizeof(float));
+        return;
+    }
+    for (int done = 0; done < frames; ) {
+        int n = frames - done;
+        if (n > OS_BLOCK) n = OS_BLOCK;
+        if (os->factor == 2) {
+            hb_up(&os->stage_a, g_hb_a, HB_A_TAPS, in + done, out + 2 * done, n);
+        } else {
+            hb_up(&os->stage_a, g_hb_a, HB_A_TAPS, in + done, mid, n);
+            hb_up(&os->stage_b, g_hb_b, HB_B_TAPS, mid, out + 4 * done, 2 * n);
+        }
+        done += n;
+    }
+}
+
+void sh101_oversampler_down(sh101_oversampler_t *os, const float *in, float *out, int frames) {
+    float mid[2 * OS_BLOCK];
+    if (os->factor == 1) {
+        if (out != in) memmove(out, in, (size_t)frames * sizeof(float));
+        return;
+    }
+    for (int done = 0; done < frames; ) {
+        int n = frames - done;
+        if (n > OS_BLOCK) n = OS_BLOCK;
+        if (os->factor == 2) {
+            hb_down(&os->stage_a, g_hb_a, HB_A_TAPS, in + 2 * done, out + done, n);
+        } else {
+            hb_down(&os->stage_b, g_hb_b, HB_B_TAPS, in + 4 * done, mid, 2 * n);
+            hb_down(&os->stage_a, g_hb_a, HB_A_TAPS, mid, out + done, n);
+        }
+        done += n;
+    }
+}
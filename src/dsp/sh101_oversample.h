@@ -0,0 +1,49 @@
+#ifndef SH101_OVERSAMPLE_H
+#define SH101_OVERSAMPLE_H
+
+/* 2x/4x oversampling with cascaded polyphase half-band FIRs.
+
+   Each 2x stage is a linear-phase half-band filter: every other tap is
+   zero and the centre tap is 0.5, so only the odd taps are stored and the
+   polyphase split runs one symmetric FIR per output sample.  Stage A
+   (base <-> 2x) has 12 coefficients (47 taps): passband ripple 0.003 dB to
+   0.204 fs, stopband below -69 dB from 0.296 fs, i.e. flat to 18 kHz and
+   rejecting everything that would fold back under 18 kHz at 44.1 kHz.
+   Stage B (2x <-> 4x) only has to clear a wide transition band and gets 4
+   coefficients (15 taps, -65 dB).
+
+   The FIRs run four outputs at a time on the sh101_fastmath vector types.
+   All state lives in sh101_oversampler_t. */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SH101_OS_MAX_FACTOR 4
+/* Input history per polyphase branch: 2 * the longest coefficient set. */
+#define SH101_OS_HIST 24
+
+typedef struct {
+    float up[SH101_OS_HIST];      /* interpolator input */
+    float dn_even[SH101_OS_HIST]; /* decimator input, even phase */
+    float dn_odd[SH101_OS_HIST];  /* decimator input, odd phase */
+} sh101_halfband_t;
+
+typedef struct {
+    int factor;                /* 1, 2 or 4 */
+    sh101_halfband_t stage_a;  /* base rate <-> 2x */
+    sh101_halfband_t stage_b;  /* 2x <-> 4x */
+} sh101_oversampler_t;
+
+/* Sets the factor (rounded to 1, 2 or 4) and clears the filter state. */
+void sh101_oversampler_init(sh101_oversampler_t *os, int factor);
+/* Interpolates `frames` base-rate samples into frames * factor samples. */
+void sh101_oversampler_up(sh101_oversampler_t *os, const float *in, float *out, int frames);
+/* Decimates frames * factor samples into `frames` base-rate samples. */
+void sh101_oversampler_down(sh101_oversampler_t *os, const float *in, float *out, int frames);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
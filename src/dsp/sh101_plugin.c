@@ -1,4 +1,5 @@
 #include <math.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -9,10 +10,16 @@
 
 #include "host/plugin_api_v1.h"
 #include "sh101_control.h"
+#include "sh101_cpu.h"
 #include "sh101_env.h"
+#include "sh101_fastmath.h"
 #include "sh101_filter.h"
 #include "sh101_lfo.h"
+#include "sh101_noise.h"
 #include "sh101_osc.h"
+#include "sh101_oversample.h"
+#include "sh101_poly.h"
+#include "sh101_quality.h"
 
 typedef enum {
     SH101_GATE_MODE_GATE = 0,
@@ -32,18 +39,39 @@ typedef enum {
     SH101_PORTA_AUTO = 2
 } sh101_portamento_mode_t;
 
-typedef enum {
-    SH101_LFO_WAVE_TRI = 0,
-    SH101_LFO_WAVE_RECT = 1,
-    SH101_LFO_WAVE_RANDOM = 2,
-    SH101_LFO_WAVE_NOISE = 3
-} sh101_lfo_waveform_t;
-
 typedef enum {
     SH101_VCA_MODE_GATE = 0,
     SH101_VCA_MODE_ENV = 1
 } sh101_vca_mode_t;
 
+/* Modulation sources (LFO, drift, envelopes, depth curves, cutoff and PWM
+   math) are evaluated once per control tick of this many samples and linearly
+   interpolated across the tick.  1 = per-sample evaluation. */
+#define SH101_CONTROL_RATE_DEFAULT 16
+#define SH101_CONTROL_RATE_MAX 32
+
+/* v2_render_block runs its stages over chunks of at most this many frames,
+   using the per-instance scratch buffers below. */
+#define SH101_RENDER_CHUNK MOVE_FRAMES_PER_BLOCK
+#define SH101_ALIGNED _Alignas(16)
+#define SH101_CACHE_LINE 64
+/* Budgets for the state the audio-rate loops touch: the per-sample prefix
+   of the instance, and the oversampler's filter histories after it. */
+#define SH101_SAMPLE_STATE_LINES 6
+#define SH101_OVERSAMPLER_LINES 10
+
+/* Per-sample coefficients below were voiced at this rate.  Each is
+   re-derived for the instance rate from the time constant it implies, so
+   the timbre does not depend on the sample rate. */
+#define SH101_TUNING_RATE 44100.0f
+/* DC blocker (VCF -> VCA coupling cap): 0.00005 per sample at 44.1 kHz. */
+#define SH101_DC_BLOCK_TAU_S 0.4535f
+/* Pitch drift slew: 0.0012 per sample at 44.1 kHz. */
+#define SH101_DRIFT_SLEW_TAU_S 0.0189f
+/* A voice must stay silent this long before it goes idle: two DC-blocker
+   time constants, so its state has settled before it is frozen. */
+#define SH101_IDLE_HOLDOFF_S (2.0f * SH101_DC_BLOCK_TAU_S)
+
 #define SH101_MAX_EXTERNAL_PRESETS 512
 #define SH101_MAX_PATH_LEN 512
 #define SH101_MAX_NAME_LEN 96
@@ -53,12 +81,106 @@ typedef struct {
     char name[SH101_MAX_NAME_LEN];
 } sh101_external_preset_t;
 
+/* Instance data render_block never reads: preset catalog, paths and
+   strings.  Allocated apart from the instance, so the voice state stays a
+   few KB instead of sharing pages with the ~300 KB catalog. */
+typedef struct {
+    char module_dir[SH101_MAX_PATH_LEN];
+    char import_name[SH101_MAX_NAME_LEN];
+    char last_error[160];
+    int external_preset_count;
+    sh101_external_preset_t external_presets[SH101_MAX_EXTERNAL_PRESETS];
+} sh101_cold_t;
+
+/* Values produced at the end of each control tick.  The audio-rate loop ramps
+   linearly from the previous tick's frame to the current one.  Pitch and
+   cutoff are summed in semitone/octave units and leave the log domain here,
+   once per tick. */
+typedef struct {
+    float freq_hz;           /* glide + LFO + bend + drift + fine tune */
+    float pwm;
+    float cutoff_g;          /* filter coefficient, see sh101_filter_cutoff_to_g */
+    float cutoff_jitter_g;   /* coefficient per unit of per-sample cutoff jitter */
+    float vca;
+    float bypass;            /* raw-oscillator blend at high cutoff */
+} sh101_mod_frame_t;
+
+/* Groups of derived values rebuilt by sync_derived.  Parameter setters and
+   MIDI handlers only mark the groups whose inputs they touched. */
+enum {
+    SH101_DIRTY_VELOCITY   = 1u << 0, /* velocity_gain, filter_velocity_gain */
+    SH101_DIRTY_DEPTHS     = 1u << 1, /* LFO depth curves incl. mod wheel */
+    SH101_DIRTY_GLIDE      = 1u << 2, /* control glide mode and coefficients */
+    SH101_DIRTY_LFO_RATE   = 1u << 3, /* synced LFO rate and increment */
+    SH101_DIRTY_KEY_FOLLOW = 1u << 4, /* cutoff key-follow ratio */
+    SH101_DIRTY_KERNEL     = 1u << 5, /* mod_kernel */
+    SH101_DIRTY_QUALITY    = 1u << 6, /* tier-dependent DSP settings */
+    SH101_DIRTY_TRANSPOSE  = 1u << 7, /* pitch of held poly voices */
+    SH101_DIRTY_ALL        = (1u << 8) - 1u
+};
+
+/* Audio-rate noise consumers.  Each draws from its own stream so that
+   enabling one never shifts the sequence another sees. */
+enum {
+    SH101_NOISE_JITTER,      /* per-sample cutoff jitter */
+    SH101_NOISE_CHAOS,       /* self-oscillation chaos */
+    SH101_NOISE_LEAK,        /* noise leaking past the filter */
+    SH101_NOISE_STREAM_COUNT
+};
+
+/* Per-instance stage buffers: modulation, oscillator, filter, post. */
 typedef struct {
-    sh101_control_t control;
-    sh101_osc_t osc;
+    SH101_ALIGNED float freq_hz[SH101_RENDER_CHUNK];
+    SH101_ALIGNED float pwm[SH101_RENDER_CHUNK];
+    SH101_ALIGNED float cutoff_g[SH101_RENDER_CHUNK];
+    SH101_ALIGNED float vca[SH101_RENDER_CHUNK];
+    SH101_ALIGNED float bypass[SH101_RENDER_CHUNK];
+    SH101_ALIGNED float self_amp[SH101_RENDER_CHUNK];
+    SH101_ALIGNED float self_inc[SH101_RENDER_CHUNK];
+    SH101_ALIGNED float self_tone[SH101_RENDER_CHUNK];
+    SH101_ALIGNED float osc[SH101_RENDER_CHUNK];
+    SH101_ALIGNED float filtered[SH101_RENDER_CHUNK];
+    SH101_ALIGNED float noise[SH101_RENDER_CHUNK];
+    SH101_ALIGNED float lfo[SH101_RENDER_CHUNK];
+    sh101_lfo_events_t lfo_events; /* filled in LFO gate mode only */
+    /* Oversampled filter input, coefficient and output. */
+    SH101_ALIGNED float os_in[SH101_RENDER_CHUNK * SH101_OS_MAX_FACTOR];
+    SH101_ALIGNED float os_g[SH101_RENDER_CHUNK * SH101_OS_MAX_FACTOR];
+    SH101_ALIGNED float os_out[SH101_RENDER_CHUNK * SH101_OS_MAX_FACTOR];
+} sh101_scratch_t;
+
+struct sh101_instance;
+
+/* One control tick of modulation; see compute_mod_frame. */
+typedef void (*sh101_mod_kernel_fn)(struct sh101_instance *inst,
+                                    int start,
+                                    int frames,
+                                    sh101_mod_frame_t *out,
+                                    float *self_amp_target,
+                                    float *self_inc);
+
+/* The state the per-sample loops read and write comes first, then the
+   oversampler histories, the per-tick voice and patch state, the scratch
+   buffers, note-event bookkeeping, the once-per-block quality settings and
+   the poly voice pool; see the static asserts below the struct. */
+typedef struct sh101_instance {
+    _Alignas(SH101_CACHE_LINE) sh101_osc_t osc;
+    sh101_filter_t filter;
+    sh101_noise_t noise[SH101_NOISE_STREAM_COUNT];
+    /* Self-oscillation sine as a rotating (cos, sin) pair; the rotation is
+       recomputed only when the per-sample increment changes. */
+    float self_osc_cos;
+    float self_osc_sin;
+    float self_osc_inc;    /* cycles per sample the rotation was built for */
+    float self_osc_rot_cos;
+    float self_osc_rot_sin;
+    float self_osc_level;  /* smoothed self-osc amplitude for gradual ramp-up/decay */
+    float dc_block;        /* DC-blocking filter state (models VCF→VCA coupling cap) */
+    float dc_coef;         /* DC blocker one-pole coefficient */
+    _Alignas(SH101_CACHE_LINE) sh101_oversampler_t oversampler; /* factor 1 = filter runs at the host rate */
+    _Alignas(SH101_CACHE_LINE) sh101_control_t control;
     sh101_env_t amp_env;
     sh101_env_t filt_env;
-    sh101_filter_t filter;
     sh101_lfo_t lfo;
 
     float saw_level;
@@ -79,12 +201,9 @@ typedef struct {
     float lfo_pitch;
     float lfo_filter;
     float lfo_pwm;
-    int lfo_waveform;
     int lfo_trigger;
     int lfo_sync;
-    int lfo_invert;
     int lfo_pitch_snap;
-    float lfo_sh_value;
     int lfo_gate_on;       /* tracks LFO gate state for LFO gate mode */
     int lfo_gate_off_count; /* number of gate-off transitions in LFO gate mode */
 
@@ -97,7 +216,14 @@ typedef struct {
     float pitch_bend_semitones;
     float pitch_bend;
     float mod_wheel;
-    uint32_t drift_rng;
+    /* depth_curve of the LFO depths with the mod-wheel boost applied. */
+    float lfo_pitch_depth;
+    float lfo_filter_depth;
+    float lfo_pwm_depth;
+    float key_follow_gain;   /* key_follow_ratio for key_follow_note */
+    int key_follow_note;     /* -1 = key_follow_gain is stale */
+    unsigned dirty;          /* SH101_DIRTY_* groups awaiting sync_derived */
+    uint32_t drift_rng;      /* per-tick draws of the drift walk */
     float drift_target_st;
     float drift_st;
     float fine_tune_cents;
@@ -116,21 +242,46 @@ typedef struct {
     int trigger_count;
     int last_triggered_note;
     float adsr_declick;
-    float self_osc_phase;
-    float self_osc_level;  /* smoothed self-osc amplitude for gradual ramp-up/decay */
     float prev_cutoff;     /* previous frame's modulated cutoff for stability tracking */
-    float dc_block;        /* DC-blocking filter state (models VCF→VCA coupling cap) */
+    float tuning_ratio;    /* SH101_TUNING_RATE / sample rate */
+    int idle_holdoff;      /* SH101_IDLE_HOLDOFF_S in samples */
+    int silent_frames;     /* frames rendered since the voice fell silent */
+    int idle;              /* 1 = render_block skips the audio chain (see voice_is_silent) */
+    int output_mix;        /* 1 = render_block adds into the host buffer instead of overwriting */
+    int output_host;       /* 1 = render_block writes to the host's mapped audio output, not its buffer */
+    int control_rate;      /* samples per modulation tick, after the quality tier */
+    int cutoff_jitter;     /* 0 = no per-sample cutoff jitter (Eco tier) */
+    int filter_model;      /* sh101_filter_model_t */
+    float drift_walk_scale; /* drift random-walk step per tick */
+    float drift_slew;       /* drift one-pole coefficient per tick */
+    sh101_mod_frame_t mod_prev;
+    int mod_valid;         /* 0 = next tick starts its ramps from the current frame */
+    sh101_mod_kernel_fn mod_kernel; /* chosen by select_mod_kernel */
+    sh101_cold_t *cold;
+    _Alignas(SH101_CACHE_LINE) sh101_scratch_t scratch;
     float active_velocity;
     float held_velocity[128];
-    char import_name[96];
-    int external_preset_count;
-    char module_dir[SH101_MAX_PATH_LEN];
-    sh101_external_preset_t external_presets[SH101_MAX_EXTERNAL_PRESETS];
-
-    char last_error[160];
+    /* Settings as the user made them; apply_quality derives the values in
+       effect from these and the active tier. */
+    int control_rate_param;
+    int oversampling_param; /* factor 1, 2 or 4 */
+    int band_limited_param;
+    int adaa_param;
+    sh101_quality_state_t quality;
+    int quality_auto;      /* 1 = step down on deadline overruns */
+    uint32_t meter_round;  /* see sh101_quality_meter_add */
+    int polymode;          /* 1 = notes play on the voice pool instead of the mono voice */
+    int poly_voices;       /* voices that take new notes; any above ring out their release */
+    _Alignas(SH101_CACHE_LINE) sh101_poly_t poly;
 } sh101_instance_t;
 
+_Static_assert(offsetof(sh101_instance_t, oversampler) <= SH101_SAMPLE_STATE_LINES * SH101_CACHE_LINE,
+               "per-sample state outgrew its cache-line budget");
+_Static_assert(sizeof(sh101_oversampler_t) <= SH101_OVERSAMPLER_LINES * SH101_CACHE_LINE,
+               "oversampler histories outgrew their cache-line budget");
+
 static const host_api_v1_t *g_host = NULL;
+static sh101_quality_meter_t g_meter;
 
 typedef struct {
     const char *name;
@@ -303,13 +454,13 @@ static int clamp_int(int v, int lo, int hi) {
 }
 
 static void clear_error(sh101_instance_t *inst) {
-    inst->last_error[0] = '\0';
+    inst->cold->last_error[0] = '\0';
 }
 
 static void set_errorf(sh101_instance_t *inst, const char *fmt, ...) {
     va_list ap;
     va_start(ap, fmt);
-    vsnprintf(inst->last_error, sizeof(inst->last_error), fmt, ap);
+    vsnprintf(inst->cold->last_error, sizeof(inst->cold->last_error), fmt, ap);
     va_end(ap);
 }
 
@@ -323,6 +474,11 @@ static float rand_unit(uint32_t *state) {
     return (float)((*state >> 8) & 0x00FFFFFFu) / 16777215.0f;
 }
 
+static void reset_self_osc_phase(sh101_instance_t *inst) {
+    inst->self_osc_cos = 1.0f;
+    inst->self_osc_sin = 0.0f;
+}
+
 static const char* find_bytes(const char *hay, size_t hay_len, const char *needle, size_t needle_len) {
     if (!hay || !needle || needle_len == 0 || hay_len < needle_len) return NULL;
     size_t max_i = hay_len - needle_len;
@@ -428,6 +584,8 @@ static int tal_dco_range_octaves(float value) {
 }
 
 static int import_vstpreset_path(sh101_instance_t *inst, const char *path);
+static void select_mod_kernel(sh101_instance_t *inst);
+static void set_polymode(sh101_instance_t *inst, int on);
 
 static int load_file_blob(const char *path, char **blob_out, size_t *blob_len_out) {
     FILE *fp;
@@ -506,7 +664,7 @@ static void scan_external_presets_recursive(sh101_instance_t *inst, const char *
     DIR *dir;
     struct dirent *ent;
 
-    if (inst->external_preset_count >= SH101_MAX_EXTERNAL_PRESETS) return;
+    if (inst->cold->external_preset_count >= SH101_MAX_EXTERNAL_PRESETS) return;
     dir = opendir(dir_path);
     if (!dir) return;
 
@@ -528,19 +686,19 @@ static void scan_external_presets_recursive(sh101_instance_t *inst, const char *
             continue;
         }
         if (!S_ISREG(st.st_mode) || !has_vstpreset_ext(ent->d_name)) continue;
-        if (inst->external_preset_count >= SH101_MAX_EXTERNAL_PRESETS) break;
+        if (inst->cold->external_preset_count >= SH101_MAX_EXTERNAL_PRESETS) break;
         if (!load_file_blob(full, &blob, &blob_len)) continue;
         if (!tal_extract_xml(blob, blob_len, &xml, &xml_len)) {
             free(blob);
             continue;
         }
 
-        dst = &inst->external_presets[inst->external_preset_count];
+        dst = &inst->cold->external_presets[inst->cold->external_preset_count];
         snprintf(dst->path, sizeof(dst->path), "%s", full);
         if (!tal_attr_get_string(xml, xml_len, "programname", dst->name, sizeof(dst->name))) {
             basename_no_ext(full, dst->name, sizeof(dst->name));
         }
-        inst->external_preset_count += 1;
+        inst->cold->external_preset_count += 1;
         free(blob);
     }
     closedir(dir);
@@ -548,14 +706,14 @@ static void scan_external_presets_recursive(sh101_instance_t *inst, const char *
 
 static void scan_external_presets(sh101_instance_t *inst) {
     char presets_dir[SH101_MAX_PATH_LEN];
-    inst->external_preset_count = 0;
-    if (inst->module_dir[0] == '\0') return;
-    if (snprintf(presets_dir, sizeof(presets_dir), "%s/presets", inst->module_dir) >= (int)sizeof(presets_dir)) return;
+    inst->cold->external_preset_count = 0;
+    if (inst->cold->module_dir[0] == '\0') return;
+    if (snprintf(presets_dir, sizeof(presets_dir), "%s/presets", inst->cold->module_dir) >= (int)sizeof(presets_dir)) return;
     scan_external_presets_recursive(inst, presets_dir);
-    if (inst->external_preset_count > 1) {
-        qsort(inst->external_presets,
-              (size_t)inst->external_preset_count,
-              sizeof(inst->external_presets[0]),
+    if (inst->cold->external_preset_count > 1) {
+        qsort(inst->cold->external_presets,
+              (size_t)inst->cold->external_preset_count,
+              sizeof(inst->cold->external_presets[0]),
               external_preset_name_cmp);
     }
 }
@@ -568,11 +726,9 @@ static void sh101_log(const char *msg) {
     }
 }
 
-static float note_to_cutoff_hz(int note, float cutoff_norm, float key_follow) {
-    float base = 30.0f + cutoff_norm * cutoff_norm * 15000.0f;
-    float k = ((float)note - 60.0f) / 12.0f;
-    float follow = powf(2.0f, k * key_follow);
-    return clampf(base * follow, 20.0f, 18000.0f);
+/* Key-follow as a frequency ratio: `key_follow` octaves per octave from C4. */
+static float key_follow_ratio(int note, float key_follow) {
+    return sh101_fast_exp2f(((float)note - 60.0f) * (1.0f / 12.0f) * key_follow);
 }
 
 static float pick_active_note_velocity(const sh101_instance_t *inst) {
@@ -581,6 +737,17 @@ static float pick_active_note_velocity(const sh101_instance_t *inst) {
     return clampf(inst->held_velocity[note], 0.0f, 1.0f);
 }
 
+/* Amp and filter gains for a note velocity at the current sensitivities. */
+static void velocity_gains(const sh101_instance_t *inst, float velocity, float *amp, float *filt) {
+    float vel = clampf(velocity, 0.0f, 1.0f);
+    float shaped = powf(vel, 0.60f); /* Concave response keeps low-mid resolution musical. */
+    float amp_floor = 1.0f - 0.75f * inst->velocity_sens;
+    float filt_floor = 1.0f - 0.45f * inst->filter_velocity_sens;
+
+    *amp = clampf(amp_floor + (1.0f - amp_floor) * shaped, 0.05f, 1.0f);
+    *filt = clampf(filt_floor + (1.0f - filt_floor) * shaped, 0.05f, 1.0f);
+}
+
 static void apply_velocity_response(sh101_instance_t *inst) {
     if (inst->velocity_mode == SH101_VELOCITY_MODE_OFF) {
         inst->active_velocity = 1.0f;
@@ -588,14 +755,37 @@ static void apply_velocity_response(sh101_instance_t *inst) {
         inst->filter_velocity_gain = 1.0f;
         return;
     }
+    velocity_gains(inst, inst->active_velocity, &inst->velocity_gain, &inst->filter_velocity_gain);
+}
 
-    float vel = clampf(inst->active_velocity, 0.0f, 1.0f);
-    float shaped = powf(vel, 0.60f); /* Concave response keeps low-mid resolution musical. */
-    float amp_floor = 1.0f - 0.75f * inst->velocity_sens;
-    float filt_floor = 1.0f - 0.45f * inst->filter_velocity_sens;
+/* Poly voices respond to their own note's velocity in either velocity mode. */
+static void poly_voice_velocity(sh101_instance_t *inst, int v) {
+    sh101_poly_t *p = &inst->poly;
+    if (inst->velocity_mode == SH101_VELOCITY_MODE_OFF) {
+        p->amp_gain[v] = 1.0f;
+        p->filt_gain[v] = 1.0f;
+        return;
+    }
+    velocity_gains(inst, p->velocity[v], &p->amp_gain[v], &p->filt_gain[v]);
+}
 
-    inst->velocity_gain = clampf(amp_floor + (1.0f - amp_floor) * shaped, 0.05f, 1.0f);
-    inst->filter_velocity_gain = clampf(filt_floor + (1.0f - filt_floor) * shaped, 0.05f, 1.0f);
+/* A poly voice's pitch in semitones: its key with transpose. */
+static float poly_pitch(const sh101_instance_t *inst, int note) {
+    return (float)clamp_int(note + inst->control.transpose, 0, 127);
+}
+
+/* Velocity, key-follow and transpose refresh for the pool after a
+   parameter change. */
+static void sync_poly_voices(sh101_instance_t *inst, unsigned dirty) {
+    sh101_poly_t *p = &inst->poly;
+    for (int v = 0; v < SH101_POLY_MAX_VOICES; ++v) {
+        if (p->note[v] < 0) continue;
+        if (dirty & SH101_DIRTY_VELOCITY) poly_voice_velocity(inst, v);
+        if (dirty & SH101_DIRTY_KEY_FOLLOW) p->follow[v] = key_follow_ratio(p->note[v], inst->key_follow);
+        /* Held keys retune with transpose, as the mono voice's held note
+           does; released voices keep their pitch. */
+        if ((dirty & SH101_DIRTY_TRANSPOSE) && p->gate[v]) p->pitch_st[v] = poly_pitch(inst, p->note[v]);
+    }
 }
 
 static void sync_priority_from_mode(sh101_instance_t *inst) {
@@ -607,16 +797,10 @@ static void sync_priority_from_mode(sh101_instance_t *inst) {
 }
 
 static void sync_portamento_mode(sh101_instance_t *inst) {
-    inst->control.glide_always = 0;
-    inst->control.glide_linear = inst->portamento_linear ? 1 : 0;
-    if (inst->portamento_mode == SH101_PORTA_OFF) {
-        inst->control.glide_ms = 0.0f;
-        return;
-    }
-    if (inst->portamento_mode == SH101_PORTA_ON) {
-        inst->control.glide_always = 1;
-    }
-    inst->control.glide_ms = inst->glide_ms_param;
+    inst->control.glide_always = (inst->portamento_mode == SH101_PORTA_ON) ? 1 : 0;
+    sh101_control_set_glide(&inst->control,
+                            (inst->portamento_mode == SH101_PORTA_OFF) ? 0.0f : inst->glide_ms_param,
+                            inst->portamento_linear);
 }
 
 static float quantize_lfo_rate_sync(float rate_hz) {
@@ -645,6 +829,90 @@ static void sync_lfo_rate_mode(sh101_instance_t *inst) {
     sh101_lfo_set_rate_hz(&inst->lfo, rate);
 }
 
+static void sync_control_rate(sh101_instance_t *inst) {
+    float n = (float)inst->control_rate;
+    /* The per-sample drift walk (uniform step 8e-5 at 44.1 kHz) folded into
+       one update per tick with matching variance per second and slew time
+       constant. */
+    inst->drift_walk_scale = 0.00008f * sqrtf(n * inst->tuning_ratio);
+    inst->drift_slew = 1.0f - expf(-n / (SH101_DRIFT_SLEW_TAU_S * inst->control.sample_rate));
+}
+
+static void sync_lfo_depths(sh101_instance_t *inst) {
+    float mw_shape = depth_curve(inst->mod_wheel);
+    float pwm_depth = clampf(inst->pwm_depth + inst->lfo_pwm, 0.0f, 1.0f);
+    inst->lfo_pitch_depth = depth_curve(inst->lfo_pitch) * (1.0f + 1.4f * mw_shape);
+    inst->lfo_filter_depth = depth_curve(inst->lfo_filter) * (1.0f + 1.2f * mw_shape);
+    inst->lfo_pwm_depth = depth_curve(pwm_depth) * (1.0f + 0.6f * mw_shape);
+}
+
+/* Derives the settings in effect from the user's and the active tier:
+   Eco doubles the control-rate divisor, runs the filter at the host rate
+   with naive oscillator edges and without ADAA, and drops the per-sample
+   cutoff jitter; High halves the divisor, oversamples at least 2x and turns
+   PolyBLEP and ADAA on.  Normal uses the user's settings as they are. */
+static void apply_quality(sh101_instance_t *inst) {
+    int rate = inst->control_rate_param;
+    int factor = inst->oversampling_param;
+    int band_limited = inst->band_limited_param;
+    int adaa = inst->adaa_param;
+
+    inst->cutoff_jitter = 1;
+    if (inst->quality.active == SH101_QUALITY_ECO) {
+        rate = clamp_int(rate * 2, 1, SH101_CONTROL_RATE_MAX);
+        factor = 1;
+        band_limited = 0;
+        adaa = 0;
+        inst->cutoff_jitter = 0;
+    } else if (inst->quality.active == SH101_QUALITY_HIGH) {
+        rate = clamp_int(rate / 2, 1, SH101_CONTROL_RATE_MAX);
+        if (factor < 2) factor = 2;
+        band_limited = 1;
+        adaa = 1;
+    }
+
+    if (rate != inst->control_rate) {
+        inst->control_rate = rate;
+        sync_control_rate(inst);
+    }
+    inst->osc.band_limited = band_limited;
+    /* One flag for both saturators: the mixer soft clip feeds the ladder. */
+    inst->osc.adaa = adaa;
+    inst->filter.adaa = adaa;
+    if (factor != inst->oversampler.factor) {
+        sh101_oversampler_init(&inst->oversampler, factor);
+        sh101_filter_set_sample_rate(&inst->filter, inst->control.sample_rate * (float)factor);
+        /* Ramps hold coefficients for the old rate. */
+        inst->mod_valid = 0;
+    }
+}
+
+/* Rebuilds the derived values whose inputs changed since the last call.
+   Render, MIDI and get_param call this first, so a burst of set_param
+   calls (automation, state restore) costs one rebuild per group. */
+static void sync_derived(sh101_instance_t *inst) {
+    unsigned dirty = inst->dirty;
+    if (!dirty) return;
+    inst->dirty = 0;
+    if (dirty & SH101_DIRTY_VELOCITY) apply_velocity_response(inst);
+    if (dirty & SH101_DIRTY_DEPTHS) sync_lfo_depths(inst);
+    if (dirty & SH101_DIRTY_GLIDE) sync_portamento_mode(inst);
+    if (dirty & SH101_DIRTY_LFO_RATE) sync_lfo_rate_mode(inst);
+    if (dirty & SH101_DIRTY_KEY_FOLLOW) inst->key_follow_note = -1;
+    if (inst->polymode) sync_poly_voices(inst, dirty);
+    if (dirty & SH101_DIRTY_QUALITY) apply_quality(inst);
+    if (dirty & SH101_DIRTY_KERNEL) select_mod_kernel(inst);
+}
+
+/* Derives the rate-dependent coefficients; the control rate follows. */
+static void sync_sample_rate(sh101_instance_t *inst) {
+    float sr = inst->control.sample_rate;
+    inst->tuning_ratio = SH101_TUNING_RATE / sr;
+    inst->dc_coef = 1.0f - expf(-1.0f / (SH101_DC_BLOCK_TAU_S * sr));
+    inst->idle_holdoff = (int)(SH101_IDLE_HOLDOFF_S * sr);
+    sync_control_rate(inst);
+}
+
 static void apply_tal_program_xml(sh101_instance_t *inst, const char *xml, size_t xml_len) {
     float dco_lfo = clampf(tal_attr_get_float(xml, xml_len, "dcolfovalue", 0.0f), 0.0f, 1.0f);
     int pwm_mode = tal_three_state(tal_attr_get_float(xml, xml_len, "dcopwmmode", 0.0f));
@@ -707,30 +975,28 @@ static void apply_tal_program_xml(sh101_instance_t *inst, const char *xml, size_
     inst->key_follow = clampf(tal_attr_get_float(xml, xml_len, "filterkeyboardvalue", 0.5f), 0.0f, 1.0f);
 
     inst->glide_ms_param = clampf(tal_attr_get_float(xml, xml_len, "portamentointensity", 0.0f), 0.0f, 1.0f) * 500.0f;
-    inst->control.glide_linear = inst->portamento_linear;
-    sync_portamento_mode(inst);
 
     sh101_lfo_set_rate_hz(&inst->lfo, 0.02f + clampf(tal_attr_get_float(xml, xml_len, "lforate", 0.0f), 0.0f, 1.0f) * (40.0f - 0.02f));
-    inst->lfo_waveform = tal_lfo_waveform(tal_attr_get_float(xml, xml_len, "lfowaveform", 0.0f));
+    inst->lfo.waveform = tal_lfo_waveform(tal_attr_get_float(xml, xml_len, "lfowaveform", 0.0f));
     inst->lfo_trigger = (tal_attr_get_float(xml, xml_len, "lfotrigger", 0.0f) >= 0.5f) ? 1 : 0;
     inst->lfo_sync = (tal_attr_get_float(xml, xml_len, "lfosync", 0.0f) >= 0.5f) ? 1 : 0;
-    inst->lfo_invert = (tal_attr_get_float(xml, xml_len, "lfoinverted", 0.0f) >= 0.5f) ? 1 : 0;
+    inst->lfo.invert = (tal_attr_get_float(xml, xml_len, "lfoinverted", 0.0f) >= 0.5f) ? 1 : 0;
     inst->lfo_pitch_snap = (tal_attr_get_float(xml, xml_len, "dcolfovaluesnap", 0.0f) >= 0.5f) ? 1 : 0;
     inst->lfo_pitch = dco_lfo;
     inst->lfo_filter = clampf(tal_attr_get_float(xml, xml_len, "filtermodulationvalue", 0.0f), 0.0f, 1.0f);
     inst->lfo_pwm = pwm_depth;
-    sync_lfo_rate_mode(inst);
 
     inst->velocity_sens = velocity_sens;
     inst->filter_velocity_sens = filter_velocity_sens;
     inst->velocity_mode = velocity_mode;
     inst->active_velocity = (velocity_mode == SH101_VELOCITY_MODE_OFF) ? 1.0f : inst->active_velocity;
-    apply_velocity_response(inst);
 
     inst->gate_trig_mode = tal_adsr_mode_to_gate_mode(adsr_mode);
     inst->retrigger_on_legato = (inst->gate_trig_mode == SH101_GATE_MODE_GATE_TRIG) ? 1 : 0;
     sync_priority_from_mode(inst);
     inst->vca_mode = (tal_attr_get_float(xml, xml_len, "vcamode", 1.0f) >= 0.5f) ? SH101_VCA_MODE_ENV : SH101_VCA_MODE_GATE;
+    set_polymode(inst, tal_attr_get_float(xml, xml_len, "polymode", 0.0f) >= 0.5f);
+    inst->dirty = SH101_DIRTY_ALL;
     inst->adsr_declick = adsr_declick;
     inst->fine_tune_cents = clampf((clampf(tal_attr_get_float(xml, xml_len, "masterfinetune", 0.5f), 0.0f, 1.0f) - 0.5f) * 200.0f, -100.0f, 100.0f);
     inst->output_level = clampf(tal_attr_get_float(xml, xml_len, "volume", 0.8f), 0.0f, 1.0f) * 0.80f;
@@ -738,8 +1004,8 @@ static void apply_tal_program_xml(sh101_instance_t *inst, const char *xml, size_
     sh101_env_set_adsr(&inst->amp_env, attack, decay, sustain, release);
     sh101_env_set_adsr(&inst->filt_env, attack, decay, sustain, release);
 
-    if (!tal_attr_get_string(xml, xml_len, "programname", inst->import_name, sizeof(inst->import_name))) {
-        snprintf(inst->import_name, sizeof(inst->import_name), "Imported TAL Preset");
+    if (!tal_attr_get_string(xml, xml_len, "programname", inst->cold->import_name, sizeof(inst->cold->import_name))) {
+        snprintf(inst->cold->import_name, sizeof(inst->cold->import_name), "Imported TAL Preset");
     }
 }
 
@@ -778,7 +1044,7 @@ static void trigger_envelopes(sh101_instance_t *inst, int hard_reset) {
         float keep = clampf(inst->adsr_declick, 0.0f, 1.0f);
         inst->amp_env.value  *= keep;
         inst->filt_env.value *= keep;
-        inst->self_osc_phase = 0.0f;
+        reset_self_osc_phase(inst);
     }
     sh101_env_gate_on(&inst->amp_env, 1.0f);
     sh101_env_gate_on(&inst->filt_env, 1.0f);
@@ -800,17 +1066,17 @@ static int should_note_on_trigger(sh101_instance_t *inst, int note, int was_gate
 }
 
 static void apply_preset(sh101_instance_t *inst, int preset_index) {
-    int total = SH101_PRESET_COUNT + inst->external_preset_count;
+    int total = SH101_PRESET_COUNT + inst->cold->external_preset_count;
     int i;
     const sh101_preset_t *p;
 
     if (total <= 0) return;
     i = clamp_int(preset_index, 0, total - 1);
     if (i >= SH101_PRESET_COUNT) {
-        const sh101_external_preset_t *ext = &inst->external_presets[i - SH101_PRESET_COUNT];
+        const sh101_external_preset_t *ext = &inst->cold->external_presets[i - SH101_PRESET_COUNT];
         if (import_vstpreset_path(inst, ext->path)) {
             inst->current_preset = i;
-            snprintf(inst->import_name, sizeof(inst->import_name), "%s", ext->name);
+            snprintf(inst->cold->import_name, sizeof(inst->cold->import_name), "%s", ext->name);
         }
         return;
     }
@@ -832,12 +1098,12 @@ static void apply_preset(sh101_instance_t *inst, int preset_index) {
     inst->lfo_pitch = p->lfo_pitch;
     inst->lfo_filter = p->lfo_filter;
     inst->lfo_pwm = p->lfo_pwm;
-    inst->lfo_waveform = SH101_LFO_WAVE_TRI;
+    inst->lfo.waveform = SH101_LFO_WAVE_TRI;
     inst->lfo_trigger = 0;
     inst->lfo_sync = 0;
-    inst->lfo_invert = 0;
+    inst->lfo.invert = 0;
     inst->lfo_pitch_snap = 0;
-    inst->lfo_sh_value = 0.0f;
+    inst->lfo.sh_value = 0.0f;
     inst->lfo_gate_on = 0;
     inst->lfo_gate_off_count = 0;
     inst->output_level = p->output_level;
@@ -857,21 +1123,24 @@ static void apply_preset(sh101_instance_t *inst, int preset_index) {
     inst->filter_env_polarity = 0;
     inst->same_note_quirk = 0;
     inst->adsr_declick = 0.65f;
-    inst->self_osc_phase = 0.0f;
+    /* Factory presets are mono; a restored state re-applies its own
+       polymode after the preset. */
+    set_polymode(inst, 0);
+    reset_self_osc_phase(inst);
     inst->dc_block = 0.0f;
+    inst->silent_frames = 0;
+    inst->idle = 0;
     inst->active_velocity = 1.0f;
     inst->velocity_gain = 1.0f;
     inst->filter_velocity_gain = 1.0f;
     inst->current_preset = i;
-    snprintf(inst->import_name, sizeof(inst->import_name), "%s", p->name);
+    snprintf(inst->cold->import_name, sizeof(inst->cold->import_name), "%s", p->name);
 
     sync_priority_from_mode(inst);
-    sync_portamento_mode(inst);
     sh101_env_set_adsr(&inst->amp_env, p->amp_a, p->amp_d, p->amp_s, p->amp_r);
     sh101_env_set_adsr(&inst->filt_env, p->filt_a, p->filt_d, p->filt_s, p->filt_r);
     sh101_lfo_set_rate_hz(&inst->lfo, p->lfo_rate_hz);
-    sync_lfo_rate_mode(inst);
-    apply_velocity_response(inst);
+    inst->dirty = SH101_DIRTY_ALL;
 }
 
 static void reset_voice(sh101_instance_t *inst) {
@@ -883,13 +1152,35 @@ static void reset_voice(sh101_instance_t *inst) {
     float filt_d = inst->filt_env.decay_s;
     float filt_s = inst->filt_env.sustain;
     float filt_r = inst->filt_env.release_s;
+    int filt_adaa = inst->filter.adaa;
 
     sh101_env_init(&inst->amp_env, inst->control.sample_rate);
     sh101_env_set_adsr(&inst->amp_env, amp_a, amp_d, amp_s, amp_r);
     sh101_env_init(&inst->filt_env, inst->control.sample_rate);
     sh101_env_set_adsr(&inst->filt_env, filt_a, filt_d, filt_s, filt_r);
-    sh101_filter_init(&inst->filter, inst->control.sample_rate);
+    sh101_filter_init(&inst->filter, inst->control.sample_rate * (float)inst->oversampler.factor);
+    sh101_filter_set_model(&inst->filter, (sh101_filter_model_t)inst->filter_model);
+    inst->filter.adaa = filt_adaa;
+    sh101_oversampler_init(&inst->oversampler, inst->oversampler.factor);
     inst->prev_cutoff = inst->cutoff;
+    inst->mod_valid = 0;
+}
+
+/* Clears the key state and silences the mono voice and the voice pool. */
+static void all_notes_off(sh101_instance_t *inst) {
+    sh101_control_all_notes_off(&inst->control);
+    memset(inst->held_velocity, 0, sizeof(inst->held_velocity));
+    inst->last_triggered_note = -1;
+    inst->active_velocity = 1.0f;
+    inst->dirty |= SH101_DIRTY_VELOCITY;
+    reset_voice(inst);
+    sh101_poly_reset(&inst->poly);
+}
+
+static void set_polymode(sh101_instance_t *inst, int on) {
+    if (on == inst->polymode) return;
+    all_notes_off(inst);
+    inst->polymode = on;
 }
 
 static void init_defaults(sh101_instance_t *inst, float sr) {
@@ -918,12 +1209,12 @@ static void init_defaults(sh101_instance_t *inst, float sr) {
     inst->lfo_pitch = 0.0f;
     inst->lfo_filter = 0.0f;
     inst->lfo_pwm = 0.0f;
-    inst->lfo_waveform = SH101_LFO_WAVE_TRI;
+    inst->lfo.waveform = SH101_LFO_WAVE_TRI;
     inst->lfo_trigger = 0;
     inst->lfo_sync = 0;
-    inst->lfo_invert = 0;
+    inst->lfo.invert = 0;
     inst->lfo_pitch_snap = 0;
-    inst->lfo_sh_value = 0.0f;
+    inst->lfo.sh_value = 0.0f;
     inst->lfo_gate_on = 0;
     inst->lfo_gate_off_count = 0;
 
@@ -937,6 +1228,9 @@ static void init_defaults(sh101_instance_t *inst, float sr) {
     inst->pitch_bend = 0.0f;
     inst->mod_wheel = 0.0f;
     inst->drift_rng = 0x31415926u;
+    for (int s = 0; s < SH101_NOISE_STREAM_COUNT; ++s) {
+        sh101_noise_seed(&inst->noise[s], 0x31415926u + (uint32_t)s);
+    }
     inst->drift_target_st = 0.0f;
     inst->drift_st = 0.0f;
     inst->fine_tune_cents = 0.0f;
@@ -953,8 +1247,26 @@ static void init_defaults(sh101_instance_t *inst, float sr) {
     inst->filter_env_polarity = 0;
     inst->same_note_quirk = 0;
     inst->adsr_declick = 0.65f;
-    inst->self_osc_phase = 0.0f;
+    reset_self_osc_phase(inst);
     inst->dc_block = 0.0f;
+    inst->silent_frames = 0;
+    inst->idle = 0;
+    inst->control_rate = SH101_CONTROL_RATE_DEFAULT;
+    inst->control_rate_param = SH101_CONTROL_RATE_DEFAULT;
+    inst->oversampling_param = 1;
+    inst->band_limited_param = 0;
+    inst->adaa_param = 0;
+    inst->cutoff_jitter = 1;
+    sh101_quality_restart(&inst->quality, SH101_QUALITY_NORMAL);
+    inst->meter_round = g_meter.round - 1u;
+    inst->mod_valid = 0;
+    sync_sample_rate(inst);
+    inst->filter_model = SH101_FILTER_EULER;
+    sh101_filter_set_model(&inst->filter, SH101_FILTER_EULER);
+    sh101_oversampler_init(&inst->oversampler, 1);
+    sh101_poly_init(&inst->poly, sr);
+    inst->polymode = 0;
+    inst->poly_voices = 4;
     inst->trigger_count = 0;
     inst->last_triggered_note = -1;
     inst->active_velocity = 1.0f;
@@ -962,6 +1274,7 @@ static void init_defaults(sh101_instance_t *inst, float sr) {
 
     apply_preset(inst, 0);
     sh101_filter_set_params(&inst->filter, 1600.0f, inst->resonance, 1.2f);
+    sync_derived(inst);
 }
 
 static void* v2_create_instance(const char *module_dir, const char *json_defaults) {
@@ -969,16 +1282,58 @@ static void* v2_create_instance(const char *module_dir, const char *json_default
 
     float sr = (g_host && g_host->sample_rate > 0) ? (float)g_host->sample_rate : 44100.0f;
 
-    sh101_instance_t *inst = (sh101_instance_t*)calloc(1, sizeof(*inst));
+    sh101_instance_t *inst = (sh101_instance_t*)aligned_alloc(SH101_CACHE_LINE, sizeof(*inst));
     if (!inst) return NULL;
-    snprintf(inst->module_dir, sizeof(inst->module_dir), "%s", (module_dir && module_dir[0]) ? module_dir : ".");
+    memset(inst, 0, sizeof(*inst));
+    inst->cold = (sh101_cold_t*)calloc(1, sizeof(*inst->cold));
+    if (!inst->cold) {
+        free(inst);
+        return NULL;
+    }
+    snprintf(inst->cold->module_dir, sizeof(inst->cold->module_dir), "%s", (module_dir && module_dir[0]) ? module_dir : ".");
     init_defaults(inst, sr);
     scan_external_presets(inst);
     return inst;
 }
 
 static void v2_destroy_instance(void *instance) {
-    free(instance);
+    sh101_instance_t *inst = (sh101_instance_t*)instance;
+    if (!inst) return;
+    free(inst->cold);
+    free(inst);
+}
+
+/* Poly mode: each key gets a voice of the pool with its own velocity and
+   key follow.  The mono voice's gate modes do not apply; the LFO trigger
+   does. */
+static void poly_note_on(sh101_instance_t *inst, int note, float vel) {
+    sh101_poly_t *p = &inst->poly;
+    int v = sh101_poly_note_on(p, inst->poly_voices, note);
+
+    if (!p->fresh[v]) {
+        /* Retriggered or stolen: declick as trigger_envelopes does. */
+        float keep = clampf(inst->adsr_declick, 0.0f, 1.0f);
+        p->amp_value[v] *= keep;
+        p->filt_value[v] *= keep;
+    }
+    p->pitch_st[v] = poly_pitch(inst, note);
+    p->velocity[v] = vel;
+    p->follow[v] = key_follow_ratio(note, inst->key_follow);
+    poly_voice_velocity(inst, v);
+    if (inst->lfo_trigger) {
+        inst->lfo.phase = 0.0f;
+    }
+    inst->trigger_count += 1;
+    inst->last_triggered_note = note;
+}
+
+/* With hold off, releases the pool voices whose keys are up. */
+static void poly_release_unheld(sh101_instance_t *inst) {
+    sh101_poly_t *p = &inst->poly;
+    if (inst->control.hold_enabled) return;
+    for (int v = 0; v < SH101_POLY_MAX_VOICES; ++v) {
+        if (p->gate[v] && inst->held_velocity[p->note[v]] == 0.0f) sh101_poly_gate_off(p, v);
+    }
 }
 
 static void handle_note_on(sh101_instance_t *inst, int note, int velocity) {
@@ -988,6 +1343,11 @@ static void handle_note_on(sh101_instance_t *inst, int note, int velocity) {
     float vel = clampf((float)velocity / 127.0f, 0.0f, 1.0f);
     inst->held_velocity[note] = vel;
 
+    if (inst->polymode) {
+        poly_note_on(inst, note, vel);
+        return;
+    }
+
     sh101_control_note_on(&inst->control, note, velocity);
     if (inst->lfo_trigger) {
         inst->lfo.phase = 0.0f;
@@ -997,7 +1357,7 @@ static void handle_note_on(sh101_instance_t *inst, int note, int velocity) {
 
     if (inst->velocity_mode == SH101_VELOCITY_MODE_ACTIVE_NOTE) {
         inst->active_velocity = pick_active_note_velocity(inst);
-        apply_velocity_response(inst);
+        inst->dirty |= SH101_DIRTY_VELOCITY;
     }
 
     if (!should_note_on_trigger(inst, note, was_gate)) {
@@ -1006,9 +1366,9 @@ static void handle_note_on(sh101_instance_t *inst, int note, int velocity) {
 
     if (inst->velocity_mode == SH101_VELOCITY_MODE_TRIGGER) {
         inst->active_velocity = vel;
-        apply_velocity_response(inst);
+        inst->dirty |= SH101_DIRTY_VELOCITY;
     } else if (inst->velocity_mode == SH101_VELOCITY_MODE_OFF) {
-        apply_velocity_response(inst);
+        inst->dirty |= SH101_DIRTY_VELOCITY;
     }
 
     {
@@ -1023,11 +1383,16 @@ static void handle_note_off(sh101_instance_t *inst, int note) {
 
     int was_held = inst->control.held[note];
     inst->held_velocity[note] = 0.0f;
+
+    if (inst->polymode) {
+        poly_release_unheld(inst);
+        return;
+    }
     sh101_control_note_off(&inst->control, note);
 
     if (inst->velocity_mode == SH101_VELOCITY_MODE_ACTIVE_NOTE) {
         inst->active_velocity = pick_active_note_velocity(inst);
-        apply_velocity_response(inst);
+        inst->dirty |= SH101_DIRTY_VELOCITY;
     }
 
     if (!inst->control.gate) {
@@ -1042,7 +1407,7 @@ static void handle_note_off(sh101_instance_t *inst, int note) {
         memset(inst->held_velocity, 0, sizeof(inst->held_velocity));
         inst->last_triggered_note = -1;
         inst->active_velocity = 1.0f;
-        apply_velocity_response(inst);
+        inst->dirty |= SH101_DIRTY_VELOCITY;
         sh101_env_gate_off(&inst->amp_env);
         sh101_env_gate_off(&inst->filt_env);
     }
@@ -1052,6 +1417,7 @@ static void v2_on_midi(void *instance, const uint8_t *msg, int len, int source)
     (void)source;
     sh101_instance_t *inst = (sh101_instance_t*)instance;
     if (!inst || len < 1) return;
+    sync_derived(inst);
 
     uint8_t status = msg[0] & 0xF0;
     uint8_t d1 = (len > 1) ? msg[1] : 0;
@@ -1068,13 +1434,9 @@ static void v2_on_midi(void *instance, const uint8_t *msg, int len, int source)
     if (status == 0xB0) {
         if (d1 == 1) {
             inst->mod_wheel = (float)d2 / 127.0f;
+            inst->dirty |= SH101_DIRTY_DEPTHS;
         } else if (d1 == 123) {
-            sh101_control_all_notes_off(&inst->control);
-            memset(inst->held_velocity, 0, sizeof(inst->held_velocity));
-            inst->last_triggered_note = -1;
-            inst->active_velocity = 1.0f;
-            apply_velocity_response(inst);
-            reset_voice(inst);
+            all_notes_off(inst);
         }
         return;
     }
@@ -1109,22 +1471,37 @@ static const char *state_param_keys[] = {
     "retrigger", "gate_trig_mode", "vca_mode", "velocity_mode",
     "portamento_mode", "portamento_linear", "same_note_quirk", "adsr_declick",
     "glide", "hold", "priority", "transpose", "octave_transpose", "fine_tune",
-    "volume", "bend_range",
+    "volume", "bend_range", "control_rate", "osc_antialias", "filter_model",
+    "filter_antialias", "oversampling", "quality", "quality_auto",
+    "polymode", "poly_voices",
     NULL
 };
 
 /* Parse a value that may be a numeric index ("0", "1") or an option label
-   ("Off", "On", "Auto") from the chain UI.  Returns the index. */
+   ("Off", "On", "Auto") from the chain UI.  Labels are matched first since
+   some start with a number ("2x", "-1 Oct").  Returns the index. */
 static int parse_enum(const char *val, const char *const *opts, int count) {
     char *endptr;
-    float f = strtof(val, &endptr);
-    if (endptr != val) return clamp_int((int)f, 0, count - 1);
+    float f;
     for (int i = 0; i < count; i++) {
         if (strcmp(val, opts[i]) == 0) return i;
     }
+    f = strtof(val, &endptr);
+    if (endptr != val) return clamp_int((int)f, 0, count - 1);
     return 0;
 }
 
+/* A quality change starts over from the chosen tier. */
+static void restart_quality(sh101_instance_t *inst, int chosen) {
+    sh101_quality_restart(&inst->quality, chosen);
+    inst->dirty |= SH101_DIRTY_QUALITY;
+}
+
+/* "oversampling" option index for the current factor (1x, 2x, 4x). */
+static int oversampling_index(const sh101_instance_t *inst) {
+    return inst->oversampling_param == 4 ? 2 : (inst->oversampling_param == 2 ? 1 : 0);
+}
+
 static void v2_set_param(void *instance, const char *key, const char *val) {
     sh101_instance_t *inst = (sh101_instance_t*)instance;
     if (!inst || !key || !val) return;
@@ -1158,7 +1535,7 @@ static void v2_set_param(void *instance, const char *key, const char *val) {
     else if (strcmp(key, "white_noise") == 0) { static const char *const o[] = {"Off","On"}; inst->white_noise = parse_enum(val, o, 2); }
     else if (strcmp(key, "pulse_width") == 0) inst->pulse_width = clampf(f, 0.05f, 0.95f);
     else if (strcmp(key, "pwm_mode") == 0) { static const char *const o[] = {"Env","Manual","LFO"}; inst->pwm_mode = parse_enum(val, o, 3); }
-    else if (strcmp(key, "pwm_depth") == 0) inst->pwm_depth = clampf(f, 0.0f, 1.0f);
+    else if (strcmp(key, "pwm_depth") == 0) { inst->pwm_depth = clampf(f, 0.0f, 1.0f); inst->dirty |= SH101_DIRTY_DEPTHS; }
     else if (strcmp(key, "pwm_env_depth") == 0) inst->pwm_env_depth = clampf(f, 0.0f, 1.0f);
     else if (strcmp(key, "cutoff") == 0) inst->cutoff = clampf(f, 0.0f, 1.0f);
     else if (strcmp(key, "resonance") == 0) inst->resonance = clampf(f, 0.0f, 1.2f);
@@ -1166,18 +1543,18 @@ static void v2_set_param(void *instance, const char *key, const char *val) {
     else if (strcmp(key, "filter_volume_correction") == 0) inst->filter_volume_correction = clampf(f, 0.0f, 1.0f);
     else if (strcmp(key, "filter_env_full_range") == 0) { static const char *const o[] = {"Off","On"}; inst->filter_env_full_range = parse_enum(val, o, 2); }
     else if (strcmp(key, "filter_env_polarity") == 0) { static const char *const o[] = {"Positive","Negative"}; inst->filter_env_polarity = parse_enum(val, o, 2); }
-    else if (strcmp(key, "key_follow") == 0) inst->key_follow = clampf(f, 0.0f, 1.0f);
-    else if (strcmp(key, "lfo_rate") == 0) { sh101_lfo_set_rate_hz(&inst->lfo, clampf(f, 0.02f, 40.0f)); sync_lfo_rate_mode(inst); }
-    else if (strcmp(key, "lfo_waveform") == 0) { static const char *const o[] = {"Tri","Rect","Random","Noise"}; inst->lfo_waveform = parse_enum(val, o, 4); }
+    else if (strcmp(key, "key_follow") == 0) { inst->key_follow = clampf(f, 0.0f, 1.0f); inst->dirty |= SH101_DIRTY_KEY_FOLLOW; }
+    else if (strcmp(key, "lfo_rate") == 0) { sh101_lfo_set_rate_hz(&inst->lfo, clampf(f, 0.02f, 40.0f)); inst->dirty |= SH101_DIRTY_LFO_RATE; }
+    else if (strcmp(key, "lfo_waveform") == 0) { static const char *const o[] = {"Tri","Rect","Random","Noise"}; inst->lfo.waveform = parse_enum(val, o, 4); }
     else if (strcmp(key, "lfo_trigger") == 0) { static const char *const o[] = {"Free","Retrig"}; inst->lfo_trigger = parse_enum(val, o, 2); }
-    else if (strcmp(key, "lfo_sync") == 0) { static const char *const o[] = {"Free","Sync"}; inst->lfo_sync = parse_enum(val, o, 2); sync_lfo_rate_mode(inst); }
-    else if (strcmp(key, "lfo_invert") == 0) { static const char *const o[] = {"Off","On"}; inst->lfo_invert = parse_enum(val, o, 2); }
+    else if (strcmp(key, "lfo_sync") == 0) { static const char *const o[] = {"Free","Sync"}; inst->lfo_sync = parse_enum(val, o, 2); inst->dirty |= SH101_DIRTY_LFO_RATE; }
+    else if (strcmp(key, "lfo_invert") == 0) { static const char *const o[] = {"Off","On"}; inst->lfo.invert = parse_enum(val, o, 2); }
     else if (strcmp(key, "lfo_pitch_snap") == 0) { static const char *const o[] = {"Off","On"}; inst->lfo_pitch_snap = parse_enum(val, o, 2); }
-    else if (strcmp(key, "lfo_pitch") == 0) inst->lfo_pitch = clampf(f, 0.0f, 1.0f);
-    else if (strcmp(key, "lfo_filter") == 0) inst->lfo_filter = clampf(f, 0.0f, 1.0f);
-    else if (strcmp(key, "lfo_pwm") == 0) inst->lfo_pwm = clampf(f, 0.0f, 1.0f);
-    else if (strcmp(key, "velocity_sens") == 0) { inst->velocity_sens = clampf(f, 0.0f, 1.0f); apply_velocity_response(inst); }
-    else if (strcmp(key, "filter_velocity_sens") == 0) { inst->filter_velocity_sens = clampf(f, 0.0f, 1.0f); apply_velocity_response(inst); }
+    else if (strcmp(key, "lfo_pitch") == 0) { inst->lfo_pitch = clampf(f, 0.0f, 1.0f); inst->dirty |= SH101_DIRTY_DEPTHS; }
+    else if (strcmp(key, "lfo_filter") == 0) { inst->lfo_filter = clampf(f, 0.0f, 1.0f); inst->dirty |= SH101_DIRTY_DEPTHS; }
+    else if (strcmp(key, "lfo_pwm") == 0) { inst->lfo_pwm = clampf(f, 0.0f, 1.0f); inst->dirty |= SH101_DIRTY_DEPTHS; }
+    else if (strcmp(key, "velocity_sens") == 0) { inst->velocity_sens = clampf(f, 0.0f, 1.0f); inst->dirty |= SH101_DIRTY_VELOCITY; }
+    else if (strcmp(key, "filter_velocity_sens") == 0) { inst->filter_velocity_sens = clampf(f, 0.0f, 1.0f); inst->dirty |= SH101_DIRTY_VELOCITY; }
     else if (strcmp(key, "retrigger") == 0) { static const char *const o[] = {"Legato","Trig"}; inst->retrigger_on_legato = parse_enum(val, o, 2); }
     else if (strcmp(key, "gate_trig_mode") == 0) { static const char *const o[] = {"Gate","Gate+Trig","LFO"}; inst->gate_trig_mode = parse_enum(val, o, 3); sync_priority_from_mode(inst); }
     else if (strcmp(key, "vca_mode") == 0) { static const char *const o[] = {"Gate","Envelope"}; inst->vca_mode = parse_enum(val, o, 2); }
@@ -1189,10 +1566,10 @@ static void v2_set_param(void *instance, const char *key, const char *val) {
         } else if (inst->velocity_mode == SH101_VELOCITY_MODE_OFF) {
             inst->active_velocity = 1.0f;
         }
-        apply_velocity_response(inst);
+        inst->dirty |= SH101_DIRTY_VELOCITY;
     }
-    else if (strcmp(key, "portamento_mode") == 0) { static const char *const o[] = {"Off","On","Auto"}; inst->portamento_mode = parse_enum(val, o, 3); sync_portamento_mode(inst); }
-    else if (strcmp(key, "portamento_linear") == 0) { static const char *const o[] = {"Expo","Linear"}; inst->portamento_linear = parse_enum(val, o, 2); sync_portamento_mode(inst); }
+    else if (strcmp(key, "portamento_mode") == 0) { static const char *const o[] = {"Off","On","Auto"}; inst->portamento_mode = parse_enum(val, o, 3); inst->dirty |= SH101_DIRTY_GLIDE; }
+    else if (strcmp(key, "portamento_linear") == 0) { static const char *const o[] = {"Expo","Linear"}; inst->portamento_linear = parse_enum(val, o, 2); inst->dirty |= SH101_DIRTY_GLIDE; }
     else if (strcmp(key, "same_note_quirk") == 0) {
         static const char *const o[] = {"Off","On"};
         inst->same_note_quirk = parse_enum(val, o, 2);
@@ -1207,19 +1584,46 @@ static void v2_set_param(void *instance, const char *key, const char *val) {
     else if (strcmp(key, "f_decay") == 0) { sh101_env_set_adsr(&inst->filt_env, inst->filt_env.attack_s, clampf(f, 0.001f, 6.0f), inst->filt_env.sustain, inst->filt_env.release_s); }
     else if (strcmp(key, "f_sustain") == 0) { sh101_env_set_adsr(&inst->filt_env, inst->filt_env.attack_s, inst->filt_env.decay_s, clampf(f, 0.0f, 1.0f), inst->filt_env.release_s); }
     else if (strcmp(key, "f_release") == 0) { sh101_env_set_adsr(&inst->filt_env, inst->filt_env.attack_s, inst->filt_env.decay_s, inst->filt_env.sustain, clampf(f, 0.001f, 8.0f)); }
-    else if (strcmp(key, "glide") == 0) { inst->glide_ms_param = clampf(f, 0.0f, 500.0f); sync_portamento_mode(inst); }
-    else if (strcmp(key, "hold") == 0) { static const char *const o[] = {"Off","On"}; sh101_control_set_hold(&inst->control, parse_enum(val, o, 2)); }
+    else if (strcmp(key, "glide") == 0) { inst->glide_ms_param = clampf(f, 0.0f, 500.0f); inst->dirty |= SH101_DIRTY_GLIDE; }
+    else if (strcmp(key, "hold") == 0) { static const char *const o[] = {"Off","On"}; sh101_control_set_hold(&inst->control, parse_enum(val, o, 2)); poly_release_unheld(inst); }
     else if (strcmp(key, "priority") == 0) { static const char *const o[] = {"Last","Low"}; sh101_control_set_priority(&inst->control, parse_enum(val, o, 2) ? SH101_NOTE_PRIORITY_LOWEST : SH101_NOTE_PRIORITY_LAST); }
-    else if (strcmp(key, "transpose") == 0) sh101_control_set_transpose(&inst->control, (int)f);
-    else if (strcmp(key, "octave_transpose") == 0) sh101_control_set_transpose(&inst->control, (int)f * 12);
+    else if (strcmp(key, "transpose") == 0) { sh101_control_set_transpose(&inst->control, (int)f); inst->dirty |= SH101_DIRTY_TRANSPOSE; }
+    else if (strcmp(key, "octave_transpose") == 0) { sh101_control_set_transpose(&inst->control, (int)f * 12); inst->dirty |= SH101_DIRTY_TRANSPOSE; }
     else if (strcmp(key, "fine_tune") == 0) inst->fine_tune_cents = clampf(f, -100.0f, 100.0f);
     else if (strcmp(key, "volume") == 0) inst->output_level = clampf(f, 0.0f, 1.0f);
     else if (strcmp(key, "bend_range") == 0) inst->pitch_bend_semitones = clampf(f, 0.0f, 12.0f);
+    else if (strcmp(key, "control_rate") == 0) { inst->control_rate_param = clamp_int((int)f, 1, SH101_CONTROL_RATE_MAX); inst->dirty |= SH101_DIRTY_QUALITY; }
+    else if (strcmp(key, "osc_antialias") == 0) { static const char *const o[] = {"Off","On"}; inst->band_limited_param = parse_enum(val, o, 2); inst->dirty |= SH101_DIRTY_QUALITY; }
+    else if (strcmp(key, "filter_antialias") == 0) { static const char *const o[] = {"Off","On"}; inst->adaa_param = parse_enum(val, o, 2); inst->dirty |= SH101_DIRTY_QUALITY; }
+    else if (strcmp(key, "oversampling") == 0) { static const char *const o[] = {"1x","2x","4x"}; inst->oversampling_param = 1 << parse_enum(val, o, 3); inst->dirty |= SH101_DIRTY_QUALITY; }
+    else if (strcmp(key, "quality") == 0) { static const char *const o[] = {"Eco","Normal","High"}; restart_quality(inst, parse_enum(val, o, 3)); }
+    else if (strcmp(key, "quality_auto") == 0) { static const char *const o[] = {"Off","On"}; inst->quality_auto = parse_enum(val, o, 2); restart_quality(inst, inst->quality.chosen); }
+    else if (strcmp(key, "filter_model") == 0) {
+        static const char *const o[] = {"Classic","ZDF"};
+        int model = parse_enum(val, o, 2);
+        if (model != inst->filter_model) {
+            inst->filter_model = model;
+            sh101_filter_set_model(&inst->filter, (sh101_filter_model_t)model);
+            sh101_filter_set_model(&inst->poly.ladder, (sh101_filter_model_t)model);
+        }
+    }
+    else if (strcmp(key, "polymode") == 0) { static const char *const o[] = {"Off","On"}; set_polymode(inst, parse_enum(val, o, 2)); }
+    else if (strcmp(key, "poly_voices") == 0) {
+        int voices = clamp_int((int)f, 2, SH101_POLY_MAX_VOICES);
+        /* Voices past the new count are released and ring out; they
+           take no new notes. */
+        for (int v = voices; v < inst->poly_voices; ++v) {
+            if (inst->poly.gate[v]) sh101_poly_gate_off(&inst->poly, v);
+        }
+        inst->poly_voices = voices;
+    }
+    else if (strcmp(key, "output_mode") == 0) { static const char *const o[] = {"Replace","Mix"}; inst->output_mix = parse_enum(val, o, 2); }
+    else if (strcmp(key, "output_target") == 0) { static const char *const o[] = {"Buffer","Host Output"}; inst->output_host = parse_enum(val, o, 2); }
     else if (strcmp(key, "preset") == 0) apply_preset(inst, (int)f);
     else if (strcmp(key, "rescan_presets") == 0) {
         if (f >= 0.5f) {
             scan_external_presets(inst);
-            if (inst->current_preset >= (SH101_PRESET_COUNT + inst->external_preset_count)) {
+            if (inst->current_preset >= (SH101_PRESET_COUNT + inst->cold->external_preset_count)) {
                 inst->current_preset = 0;
             }
         }
@@ -1229,19 +1633,15 @@ static void v2_set_param(void *instance, const char *key, const char *val) {
         if (f >= 0.5f) inst->trigger_count = 0;
     }
     else if (strcmp(key, "all_notes_off") == 0) {
-        sh101_control_all_notes_off(&inst->control);
-        memset(inst->held_velocity, 0, sizeof(inst->held_velocity));
-        inst->last_triggered_note = -1;
-        if (inst->velocity_mode == SH101_VELOCITY_MODE_OFF) inst->active_velocity = 1.0f;
-        else inst->active_velocity = pick_active_note_velocity(inst);
-        apply_velocity_response(inst);
-        reset_voice(inst);
+        all_notes_off(inst);
     }
+    inst->dirty |= SH101_DIRTY_KERNEL;
 }
 
 static int v2_get_param(void *instance, const char *key, char *buf, int buf_len) {
     sh101_instance_t *inst = (sh101_instance_t*)instance;
     if (!inst || !key || !buf || buf_len <= 0) return -1;
+    sync_derived(inst);
 
     /* ---------- state save: serialize all params to JSON ---------- */
     if (strcmp(key, "state") == 0) {
@@ -1266,10 +1666,10 @@ static int v2_get_param(void *instance, const char *key, char *buf, int buf_len)
         SA(",\"filter_env_polarity\":%d", inst->filter_env_polarity);
         SA(",\"key_follow\":%.6f", (double)inst->key_follow);
         SA(",\"lfo_rate\":%.6f", (double)inst->lfo.rate_hz);
-        SA(",\"lfo_waveform\":%d", inst->lfo_waveform);
+        SA(",\"lfo_waveform\":%d", inst->lfo.waveform);
         SA(",\"lfo_trigger\":%d", inst->lfo_trigger);
         SA(",\"lfo_sync\":%d", inst->lfo_sync);
-        SA(",\"lfo_invert\":%d", inst->lfo_invert);
+        SA(",\"lfo_invert\":%d", inst->lfo.invert);
         SA(",\"lfo_pitch_snap\":%d", inst->lfo_pitch_snap);
         SA(",\"lfo_pitch\":%.6f", (double)inst->lfo_pitch);
         SA(",\"lfo_filter\":%.6f", (double)inst->lfo_filter);
@@ -1300,6 +1700,15 @@ static int v2_get_param(void *instance, const char *key, char *buf, int buf_len)
         SA(",\"fine_tune\":%.6f", (double)inst->fine_tune_cents);
         SA(",\"volume\":%.6f", (double)inst->output_level);
         SA(",\"bend_range\":%.6f", (double)inst->pitch_bend_semitones);
+        SA(",\"control_rate\":%d", inst->control_rate_param);
+        SA(",\"osc_antialias\":%d", inst->band_limited_param);
+        SA(",\"filter_model\":%d", inst->filter_model);
+        SA(",\"filter_antialias\":%d", inst->adaa_param);
+        SA(",\"oversampling\":%d", oversampling_index(inst));
+        SA(",\"quality\":%d", inst->quality.chosen);
+        SA(",\"quality_auto\":%d", inst->quality_auto);
+        SA(",\"polymode\":%d", inst->polymode);
+        SA(",\"poly_voices\":%d", inst->poly_voices);
         if (n < sz) buf[n++] = '}';
         if (n < sz) buf[n] = '\0'; else buf[sz - 1] = '\0';
         #undef SA
@@ -1328,10 +1737,10 @@ static int v2_get_param(void *instance, const char *key, char *buf, int buf_len)
     if (strcmp(key, "filter_env_polarity") == 0) { static const char *const o[] = {"Positive","Negative"}; RETE(inst->filter_env_polarity, o, 2); }
     if (strcmp(key, "key_follow") == 0) RETF(inst->key_follow);
     if (strcmp(key, "lfo_rate") == 0) RETF(inst->lfo.rate_hz);
-    if (strcmp(key, "lfo_waveform") == 0) { static const char *const o[] = {"Tri","Rect","Random","Noise"}; RETE(inst->lfo_waveform, o, 4); }
+    if (strcmp(key, "lfo_waveform") == 0) { static const char *const o[] = {"Tri","Rect","Random","Noise"}; RETE(inst->lfo.waveform, o, 4); }
     if (strcmp(key, "lfo_trigger") == 0) { static const char *const o[] = {"Free","Retrig"}; RETE(inst->lfo_trigger, o, 2); }
     if (strcmp(key, "lfo_sync") == 0) { static const char *const o[] = {"Free","Sync"}; RETE(inst->lfo_sync, o, 2); }
-    if (strcmp(key, "lfo_invert") == 0) { static const char *const o[] = {"Off","On"}; RETE(inst->lfo_invert, o, 2); }
+    if (strcmp(key, "lfo_invert") == 0) { static const char *const o[] = {"Off","On"}; RETE(inst->lfo.invert, o, 2); }
     if (strcmp(key, "lfo_pitch_snap") == 0) { static const char *const o[] = {"Off","On"}; RETE(inst->lfo_pitch_snap, o, 2); }
     if (strcmp(key, "lfo_pitch") == 0) RETF(inst->lfo_pitch);
     if (strcmp(key, "lfo_filter") == 0) RETF(inst->lfo_filter);
@@ -1365,6 +1774,27 @@ static int v2_get_param(void *instance, const char *key, char *buf, int buf_len)
     if (strcmp(key, "fine_tune") == 0) RETF(inst->fine_tune_cents);
     if (strcmp(key, "volume") == 0) RETF(inst->output_level);
     if (strcmp(key, "bend_range") == 0) RETF(inst->pitch_bend_semitones);
+    if (strcmp(key, "control_rate") == 0) RETI(inst->control_rate_param);
+    if (strcmp(key, "osc_antialias") == 0) { static const char *const o[] = {"Off","On"}; RETE(inst->band_limited_param, o, 2); }
+    if (strcmp(key, "filter_model") == 0) { static const char *const o[] = {"Classic","ZDF"}; RETE(inst->filter_model, o, 2); }
+    if (strcmp(key, "filter_antialias") == 0) { static const char *const o[] = {"Off","On"}; RETE(inst->adaa_param, o, 2); }
+    if (strcmp(key, "oversampling") == 0) { static const char *const o[] = {"1x","2x","4x"}; RETE(oversampling_index(inst), o, 3); }
+    if (strcmp(key, "quality") == 0) { static const char *const o[] = {"Eco","Normal","High"}; RETE(inst->quality.chosen, o, 3); }
+    if (strcmp(key, "quality_auto") == 0) { static const char *const o[] = {"Off","On"}; RETE(inst->quality_auto, o, 2); }
+    if (strcmp(key, "polymode") == 0) { static const char *const o[] = {"Off","On"}; RETE(inst->polymode, o, 2); }
+    if (strcmp(key, "poly_voices") == 0) RETI(inst->poly_voices);
+    if (strcmp(key, "output_mode") == 0) { static const char *const o[] = {"Replace","Mix"}; RETE(inst->output_mix, o, 2); }
+    if (strcmp(key, "output_target") == 0) { static const char *const o[] = {"Buffer","Host Output"}; RETE(inst->output_host, o, 2); }
+    /* Read-only diagnostics: idle state, oscillator kernel instruction set,
+       tier in effect, sounding pool voices. */
+    if (strcmp(key, "idle") == 0) RETI(inst->idle);
+    if (strcmp(key, "active_voices") == 0) {
+        int n = 0;
+        for (int v = 0; v < SH101_POLY_MAX_VOICES; ++v) n += sh101_poly_voice_active(&inst->poly, v);
+        RETI(n);
+    }
+    if (strcmp(key, "osc_isa") == 0) return snprintf(buf, (size_t)buf_len, "%s", sh101_isa_name(sh101_osc_isa()));
+    if (strcmp(key, "quality_active") == 0) { static const char *const o[] = {"Eco","Normal","High"}; RETE(inst->quality.active, o, 3); }
     if (strcmp(key, "ui_hierarchy") == 0) {
         const char *hierarchy = "{"
             "\"modes\":null,"
@@ -1418,7 +1848,7 @@ static int v2_get_param(void *instance, const char *key, char *buf, int buf_len)
                 "\"advanced\":{"
                     "\"children\":null,"
                     "\"knobs\":[\"gate_trig_mode\",\"priority\",\"velocity_mode\",\"same_note_quirk\"],"
-                    "\"params\":[\"gate_trig_mode\",\"vca_mode\",\"adsr_declick\",\"priority\",\"velocity_mode\",\"same_note_quirk\",\"filter_env_full_range\",\"filter_env_polarity\",\"filter_volume_correction\"]"
+                    "\"params\":[\"gate_trig_mode\",\"vca_mode\",\"adsr_declick\",\"priority\",\"velocity_mode\",\"same_note_quirk\",\"filter_env_full_range\",\"filter_env_polarity\",\"filter_volume_correction\",\"control_rate\",\"osc_antialias\",\"filter_model\",\"filter_antialias\",\"oversampling\",\"quality\",\"quality_auto\",\"polymode\",\"poly_voices\"]"
                 "}"
             "}"
         "}";
@@ -1430,11 +1860,11 @@ static int v2_get_param(void *instance, const char *key, char *buf, int buf_len)
         return -1;
     }
 
-    if (strcmp(key, "import_name") == 0) return snprintf(buf, (size_t)buf_len, "%s", inst->import_name);
+    if (strcmp(key, "import_name") == 0) return snprintf(buf, (size_t)buf_len, "%s", inst->cold->import_name);
     if (strcmp(key, "preset") == 0) RETI(inst->current_preset);
-    if (strcmp(key, "preset_count") == 0) RETI(SH101_PRESET_COUNT + inst->external_preset_count);
+    if (strcmp(key, "preset_count") == 0) RETI(SH101_PRESET_COUNT + inst->cold->external_preset_count);
     if (strcmp(key, "preset_name") == 0) {
-        int total = SH101_PRESET_COUNT + inst->external_preset_count;
+        int total = SH101_PRESET_COUNT + inst->cold->external_preset_count;
         int p;
         if (total <= 0) return snprintf(buf, (size_t)buf_len, "No Presets");
         p = clamp_int(inst->current_preset, 0, total - 1);
@@ -1444,7 +1874,7 @@ static int v2_get_param(void *instance, const char *key, char *buf, int buf_len)
         return snprintf(buf,
                         (size_t)buf_len,
                         "%s",
-                        inst->external_presets[p - SH101_PRESET_COUNT].name);
+                        inst->cold->external_presets[p - SH101_PRESET_COUNT].name);
     }
 
     return -1;
@@ -1453,259 +1883,724 @@ static int v2_get_param(void *instance, const char *key, char *buf, int buf_len)
 static int v2_get_error(void *instance, char *buf, int buf_len) {
     sh101_instance_t *inst = (sh101_instance_t*)instance;
     if (!inst || !buf || buf_len <= 0) return 0;
-    if (inst->last_error[0] == '\0') return 0;
-    return snprintf(buf, (size_t)buf_len, "%s", inst->last_error);
+    if (inst->cold->last_error[0] == '\0') return 0;
+    return snprintf(buf, (size_t)buf_len, "%s", inst->cold->last_error);
 }
 
-static void v2_render_block(void *instance, int16_t *out_lr, int frames) {
-    sh101_instance_t *inst = (sh101_instance_t*)instance;
-    if (!inst || !out_lr || frames <= 0) return;
+/* Self-oscillation character: analog filter resonance produces
+   a clean sinusoid.  Noise is added only by specific modulators:
+   - NOISE LFO wf (per-sample random cutoff → chaotic)
+   - Fullrange bipolar envelope (extreme cutoff swings)
+   - Large envelope sweeps (rapid FM → mildly chaotic) */
+static float self_osc_chaos(const sh101_instance_t *inst) {
+    float chaos = 0.04f;
+    if (inst->lfo.waveform == SH101_LFO_WAVE_NOISE)
+        chaos += inst->lfo_filter * 0.50f;
+    if (inst->filter_env_full_range)
+        chaos += 0.35f;
+    chaos += inst->env_amount * inst->env_amount * 0.42f;
+    return clampf(chaos, 0.0f, 0.80f);
+}
 
-    for (int i = 0; i < frames; ++i) {
-        sh101_control_tick_pitch(&inst->control);
-
-        float phase_before = inst->lfo.phase;
-        float lfo = sh101_lfo_process(&inst->lfo);
-        int lfo_cycle_wrap = (inst->lfo.phase < phase_before) ? 1 : 0;
-        if (inst->lfo_waveform == SH101_LFO_WAVE_RECT) {
-            lfo = (inst->lfo.phase < 0.5f) ? 1.0f : -1.0f;
-        } else if (inst->lfo_waveform == SH101_LFO_WAVE_RANDOM) {
-            if (lfo_cycle_wrap) {
-                inst->lfo_sh_value = rand_unit(&inst->drift_rng) * 2.0f - 1.0f;
-            }
-            lfo = inst->lfo_sh_value;
-        } else if (inst->lfo_waveform == SH101_LFO_WAVE_NOISE) {
-            lfo = rand_unit(&inst->drift_rng) * 2.0f - 1.0f;
+/* Whether the synthetic self-oscillation below can run at all: only the
+   Classic ladder with a silent oscillator mix and resonance past 1.02. */
+static int self_osc_enabled(const sh101_instance_t *inst) {
+    return inst->filter_model == SH101_FILTER_EULER &&
+           (inst->saw_level + inst->pulse_level + inst->sub_level + inst->noise_level) < 0.0005f &&
+           inst->resonance > 1.02f;
+}
+
+/* Advances the pitch drift by one tick.  It free-runs whether or not the
+   voice is sounding, so the idle path calls this too. */
+static inline void advance_drift(sh101_instance_t *inst) {
+    /* Slow random walk drift keeps the pitch center alive without obvious detune. */
+    inst->drift_target_st += (rand_unit(&inst->drift_rng) - 0.5f) * inst->drift_walk_scale;
+    inst->drift_target_st = clampf(inst->drift_target_st, -0.10f, 0.10f);
+    inst->drift_st += (inst->drift_target_st - inst->drift_st) * inst->drift_slew;
+}
+
+/* LFO gate mode: envelopes follow the sign of the LFO while a key is held. */
+static void update_lfo_gate(sh101_instance_t *inst, int lfo_positive) {
+    if (inst->lfo_gate_off_count >= 3) {
+        /* After 3 gate-off transitions the voice has decayed to
+           inaudible levels (matching TAL's internal voice management
+           which kills near-silent voices).  Keep envelopes released
+           and VCA closed until the next note-on. */
+        if (inst->lfo_gate_on) {
+            sh101_env_gate_off(&inst->amp_env);
+            sh101_env_gate_off(&inst->filt_env);
+            inst->lfo_gate_on = 0;
+        }
+    } else if (lfo_positive && !inst->lfo_gate_on) {
+        /* LFO positive edge: retrigger envelopes */
+        if (inst->velocity_mode == SH101_VELOCITY_MODE_ACTIVE_NOTE) {
+            inst->active_velocity = pick_active_note_velocity(inst);
+            apply_velocity_response(inst);
+        }
+        trigger_envelopes(inst, 1);
+        inst->lfo_gate_on = 1;
+    } else if (!lfo_positive && inst->lfo_gate_on) {
+        /* LFO negative edge: release envelopes */
+        sh101_env_gate_off(&inst->amp_env);
+        sh101_env_gate_off(&inst->filt_env);
+        inst->lfo_gate_on = 0;
+        inst->lfo_gate_off_count++;
+    }
+}
+
+/* Filter transparency: our Euler-integration 4-pole filter caps its
+   cutoff near 2.5 kHz, making it opaque above that even at max cutoff.  The real
+   CEM3320 is essentially transparent at max cutoff.  Blend in the raw
+   oscillator signal at high cutoff to restore high-frequency content
+   (especially broadband noise that the filter otherwise removes).
+   The ZDF ladder tracks to Nyquist and needs none of this. */
+static inline float filter_bypass(const sh101_instance_t *inst, float cutoff) {
+    if (cutoff <= 0.85f || inst->filter_model != SH101_FILTER_EULER) return 0.0f;
+    /* Base bypass ramps up to 50% at max cutoff.  When noise is a
+       significant part of the oscillator mix, the bypass increases
+       further (up to 85%) because the filter's g cap removes more
+       high-frequency noise than the real CEM3320 would. */
+    float osc_total = inst->saw_level + inst->pulse_level
+                    + inst->sub_level + inst->noise_level;
+    float noise_share = (osc_total > 0.01f)
+                      ? (inst->noise_level / osc_total) : 0.0f;
+    float cutoff_ramp = clampf((cutoff - 0.85f) * 6.67f, 0.0f, 1.0f);
+    float max_bypass = 0.85f + noise_share * 0.12f;
+    return clampf(0.50f * cutoff_ramp
+                + noise_share * 0.80f * cutoff_ramp,
+                  0.0f, max_bypass);
+}
+
+/* Evaluates every modulation source for the control tick covering samples
+   [start, start + frames) of the chunk and fills `out` with the values the
+   audio-rate loop should reach at the end of the tick.  Also returns the
+   self-oscillation targets for the tick.  The LFO was rendered for the
+   whole chunk by render_mod_stage.  The trailing arguments mirror set_param
+   state (LFO gate mode, gate VCA, self_osc_enabled); the kernels below pass
+   constants so each specialization drops the mode tests it does not need. */
+static inline void compute_mod_frame(sh101_instance_t *inst,
+                                     int start,
+                                     int frames,
+                                     sh101_mod_frame_t *out,
+                                     float *self_amp_target,
+                                     float *self_inc,
+                                     const int lfo_gate,
+                                     const int vca_gate,
+                                     const int self_osc) {
+    const sh101_scratch_t *sc = &inst->scratch;
+    float lfo = sc->lfo[start + frames - 1];
+    float env_amp;
+    float env_filt;
+
+    advance_drift(inst);
+
+    if (lfo_gate && inst->control.gate) {
+        /* The gate is evaluated at the tick start and again at each LFO
+           sign change inside the tick; the envelopes are advanced up to
+           every change so retriggers and releases land on its sample. */
+        const sh101_lfo_events_t *ev = &sc->lfo_events;
+        int end = start + frames;
+        int pos = start;
+        update_lfo_gate(inst, sc->lfo[start] > 0.0f);
+        for (int e = 0; e < ev->edge_count; ++e) {
+            int at = ev->edge[e];
+            if (at <= start || at >= end) continue;
+            sh101_env_advance(&inst->amp_env, at - pos);
+            sh101_env_advance(&inst->filt_env, at - pos);
+            pos = at;
+            update_lfo_gate(inst, sc->lfo[at] > 0.0f);
         }
-        if (inst->lfo_invert) {
-            lfo = -lfo;
+        env_amp = sh101_env_advance(&inst->amp_env, end - pos);
+        env_filt = sh101_env_advance(&inst->filt_env, end - pos);
+    } else {
+        env_amp = sh101_env_advance(&inst->amp_env, frames);
+        env_filt = sh101_env_advance(&inst->filt_env, frames);
+    }
+
+    float vca_amp = env_amp;
+    if (vca_gate) {
+        vca_amp = inst->control.gate ? 1.0f : 0.0f;
+        /* In LFO gate mode, the LFO controls the VCA gate — the VCA opens
+           during the positive half of the LFO cycle and closes otherwise.
+           After the voice has cycled through 3 gate-offs, the VCA stays
+           closed (the voice is effectively silent by that point). */
+        if (lfo_gate && inst->control.gate) {
+            vca_amp = (inst->lfo_gate_off_count >= 3) ? 0.0f
+                    : (lfo > 0.0f) ? 1.0f : 0.0f;
         }
+    }
+    out->vca = vca_amp * inst->velocity_gain * inst->output_level;
 
-        if (inst->gate_trig_mode == SH101_GATE_MODE_LFO && inst->control.gate) {
-            int lfo_positive = (lfo > 0.0f) ? 1 : 0;
-            if (inst->lfo_gate_off_count >= 3) {
-                /* After 3 gate-off transitions the voice has decayed to
-                   inaudible levels (matching TAL's internal voice management
-                   which kills near-silent voices).  Keep envelopes released
-                   and VCA closed until the next note-on. */
-                if (inst->lfo_gate_on) {
-                    sh101_env_gate_off(&inst->amp_env);
-                    sh101_env_gate_off(&inst->filt_env);
-                    inst->lfo_gate_on = 0;
-                }
-            } else if (lfo_positive && !inst->lfo_gate_on) {
-                /* LFO positive edge: retrigger envelopes */
-                if (inst->velocity_mode == SH101_VELOCITY_MODE_ACTIVE_NOTE) {
-                    inst->active_velocity = pick_active_note_velocity(inst);
-                    apply_velocity_response(inst);
-                }
-                trigger_envelopes(inst, 1);
-                inst->lfo_gate_on = 1;
-            } else if (!lfo_positive && inst->lfo_gate_on) {
-                /* LFO negative edge: release envelopes */
-                sh101_env_gate_off(&inst->amp_env);
-                sh101_env_gate_off(&inst->filt_env);
-                inst->lfo_gate_on = 0;
-                inst->lfo_gate_off_count++;
-            }
+    float pitch_depth = inst->lfo_pitch_depth;
+    float filter_depth = inst->lfo_filter_depth;
+    float pwm_mod_depth = inst->lfo_pwm_depth;
+
+    float pitch_mod_st = lfo * pitch_depth * 0.85f;
+    if (inst->lfo_pitch_snap) {
+        pitch_mod_st = roundf(pitch_mod_st * 12.0f) / 12.0f;
+    }
+    float bend_st = inst->pitch_bend * inst->pitch_bend_semitones;
+    float drift_st = inst->drift_st;
+    float fine_st = inst->fine_tune_cents / 100.0f;
+    float glide_st = sh101_control_advance_pitch(&inst->control, frames);
+    out->freq_hz = sh101_pitch_st_to_hz(glide_st + pitch_mod_st + bend_st + drift_st + fine_st);
+
+    float pwm_lfo = (inst->pwm_mode == 2) ? (lfo * pwm_mod_depth * 0.42f) : 0.0f;
+    float pwm_env = (inst->pwm_mode == 0) ? ((env_amp * 2.0f - 1.0f) * inst->pwm_env_depth * 0.45f) : 0.0f;
+    out->pwm = clampf(inst->pulse_width + pwm_lfo + pwm_env, 0.05f, 0.95f);
+
+    int note_for_filter = (inst->control.current_note < 0) ? 60 : inst->control.current_note;
+    float env_delta = inst->env_amount * env_filt;
+    if (inst->filter_env_full_range && !inst->filter_env_polarity)
+        env_delta *= 2.0f;
+    if (inst->filter_env_polarity) env_delta = -env_delta;
+    float cutoff_raw = inst->cutoff
+                     + env_delta
+                     + (inst->filter_velocity_gain - 1.0f) * 0.6f
+                     + lfo * filter_depth * 0.50f;
+    float cutoff = clampf(cutoff_raw, 0.0f, 1.0f);
+
+    /* Per-sample cutoff noise models analog component drift — reduces
+       autocorrelation to match TAL's built-in analog modeling (~0.4-0.5 vs our 0.95+).
+       When the oscillator already carries noise, the cutoff jitter is reduced to
+       avoid double-randomizing the signal (which would push autocorr too low).
+       The jitter stays audio-rate; it is applied through the local slope of
+       the cutoff curve so the tick only evaluates the curve once. */
+    {
+        float noise_atten = 1.0f - inst->noise_level * 0.75f;
+        if (note_for_filter != inst->key_follow_note) {
+            inst->key_follow_note = note_for_filter;
+            inst->key_follow_gain = key_follow_ratio(note_for_filter, inst->key_follow);
+        }
+        float follow = inst->key_follow_gain;
+        float base = 30.0f + cutoff * cutoff * 15000.0f;
+        float cutoff_hz = clampf(base * follow, 20.0f, 18000.0f);
+        float jitter_hz = 0.025f * noise_atten * 2.0f * cutoff * 15000.0f * follow;
+        out->cutoff_g = sh101_filter_cutoff_to_g(&inst->filter, cutoff_hz);
+        out->cutoff_jitter_g = inst->cutoff_jitter ? sh101_filter_cutoff_to_g(&inst->filter, jitter_hz) : 0.0f;
+    }
+
+    out->bypass = filter_bypass(inst, cutoff);
+
+    /* Synthetic self-oscillation for presets with no oscillator signal and
+       high resonance.  Models the CEM3320 ladder filter's natural tendency
+       to self-oscillate at the resonant frequency.  The build-up speed is
+       cutoff-dependent: low cutoff = slow energy circulation in the filter
+       loop = slow build-up, matching TAL's behavior (50-200ms).  The ZDF
+       ladder self-oscillates on its own. */
+    *self_amp_target = 0.0f;
+    *self_inc = 0.0f;
+    if (self_osc && fmaxf(env_amp, env_filt) > 0.01f) {
+        float res_drive = clampf((inst->resonance - 1.0f) / 0.20f, 0.0f, 1.0f);
+        /* Self-osc amplitude rises with cutoff — matches analog filter
+           where higher cutoff = more energy in the feedback loop. */
+        float cutoff_amp = clampf(cutoff * 0.80f, 0.0f, 0.60f);
+        /* Suppress for extreme cutoff overshoot (beyond Nyquist). */
+        if (cutoff_raw > 1.4f) {
+            float lfo_swing = filter_depth * 0.50f;
+            float rolloff = clampf((1.8f - cutoff_raw) / 0.4f, 0.0f, 1.0f);
+            float lfo_sustain = clampf(lfo_swing * 5.0f, 0.0f, 1.0f);
+            cutoff_amp *= fmaxf(rolloff, lfo_sustain);
+        }
+        float chaos = self_osc_chaos(inst);
+        float self_freq = sh101_pitch_st_to_hz((float)note_for_filter + (cutoff - 0.45f) * (2.6f * 12.0f));
+        self_freq = clampf(self_freq, 20.0f, 8000.0f);
+        *self_inc = clampf(self_freq / inst->control.sample_rate, 0.0f, 0.45f);
+        /* Envelope sweep suppression: when a non-fullrange envelope
+           sweeps the cutoff WITHOUT chaotic modulation (no LFO filter
+           mod, low chaos), the smooth cutoff change disrupts the filter
+           feedback loop — it can't build coherent self-oscillation.
+           Presets with NOISE LFO, high LFO filter mod, or fullrange env
+           create chaotic oscillation that persists through sweeps. */
+        float env_suppress = 1.0f;
+        if (chaos < 0.25f && !inst->filter_env_full_range
+            && inst->lfo_filter < 0.1f) {
+            env_suppress = clampf(1.0f - inst->env_amount * inst->env_amount * 3.0f,
+                                  0.0f, 1.0f);
+        }
+        *self_amp_target = cutoff_amp * res_drive * env_suppress;
+    }
+}
+
+/* Fallback for the rarer mode combinations (LFO gate mode, gate VCA). */
+static void mod_kernel_generic(sh101_instance_t *inst,
+                               int start,
+                               int frames,
+                               sh101_mod_frame_t *out,
+                               float *self_amp_target,
+                               float *self_inc) {
+    compute_mod_frame(inst, start, frames, out, self_amp_target, self_inc,
+                      inst->gate_trig_mode == SH101_GATE_MODE_LFO,
+                      inst->vca_mode == SH101_VCA_MODE_GATE,
+                      self_osc_enabled(inst));
+}
+
+/* Envelope-gated VCA with a keyboard gate, with and without the synthetic
+   self-oscillation.  The LFO waveform is handled by the LFO's own block
+   kernels. */
+#define SH101_MOD_KERNEL(name, self_osc)                                    \
+    static void name(sh101_instance_t *inst, int start, int frames,         \
+                     sh101_mod_frame_t *out, float *self_amp_target,        \
+                     float *self_inc) {                                     \
+        compute_mod_frame(inst, start, frames, out, self_amp_target,        \
+                          self_inc, 0, 0, self_osc);                        \
+    }
+SH101_MOD_KERNEL(mod_kernel_env, 0)
+SH101_MOD_KERNEL(mod_kernel_env_self, 1)
+#undef SH101_MOD_KERNEL
+
+/* Picks the modulation kernel for the current modes.  Called whenever a
+   parameter may have changed, so the tick loop never re-tests them. */
+static void select_mod_kernel(sh101_instance_t *inst) {
+    if (inst->gate_trig_mode == SH101_GATE_MODE_LFO ||
+        inst->vca_mode == SH101_VCA_MODE_GATE) {
+        inst->mod_kernel = mod_kernel_generic;
+    } else {
+        inst->mod_kernel = self_osc_enabled(inst) ? mod_kernel_env_self : mod_kernel_env;
+    }
+}
+
+/* Stage 1: control-rate modulation, ramped into per-sample buffers. */
+static int render_mod_stage(sh101_instance_t *inst, int frames) {
+    sh101_scratch_t *sc = &inst->scratch;
+    int self_osc_active = 0;
+
+    /* Edge offsets are only needed by the LFO gate mode. */
+    sh101_lfo_render_block(&inst->lfo, sc->lfo, frames,
+                           inst->gate_trig_mode == SH101_GATE_MODE_LFO ? &sc->lfo_events : NULL);
+
+    for (int start = 0; start < frames; ) {
+        int n = frames - start;
+        if (n > inst->control_rate) n = inst->control_rate;
+
+        sh101_mod_frame_t cur;
+        float self_amp_target, self_inc;
+        inst->mod_kernel(inst, start, n, &cur, &self_amp_target, &self_inc);
+        if (!inst->mod_valid) {
+            inst->mod_prev = cur;
+            inst->mod_valid = 1;
         }
+        if (self_inc > 0.0f) self_osc_active = 1;
 
-        /* Slow random walk drift keeps the pitch center alive without obvious detune. */
-        inst->drift_target_st += (rand_unit(&inst->drift_rng) - 0.5f) * 0.00008f;
-        inst->drift_target_st = clampf(inst->drift_target_st, -0.10f, 0.10f);
-        inst->drift_st += (inst->drift_target_st - inst->drift_st) * 0.0012f;
-
-        float env_amp = sh101_env_process(&inst->amp_env);
-        float vca_amp = env_amp;
-        float env_filt = sh101_env_process(&inst->filt_env);
-        if (inst->vca_mode == SH101_VCA_MODE_GATE) {
-            vca_amp = inst->control.gate ? 1.0f : 0.0f;
-            /* In LFO gate mode, the LFO controls the VCA gate — the VCA opens
-               during the positive half of the LFO cycle and closes otherwise.
-               After the voice has cycled through 3 gate-offs, the VCA stays
-               closed (the voice is effectively silent by that point). */
-            if (inst->gate_trig_mode == SH101_GATE_MODE_LFO && inst->control.gate) {
-                vca_amp = (inst->lfo_gate_off_count >= 3) ? 0.0f
-                        : (lfo > 0.0f) ? 1.0f : 0.0f;
+        /* Linear ramps from the previous tick keep envelope attacks and
+           gate edges click-free. */
+        {
+            const sh101_mod_frame_t *m = &inst->mod_prev;
+            float inv_n = 1.0f / (float)n;
+            float d_freq = (cur.freq_hz - m->freq_hz) * inv_n;
+            float d_pwm = (cur.pwm - m->pwm) * inv_n;
+            float d_cutoff = (cur.cutoff_g - m->cutoff_g) * inv_n;
+            float d_jitter = (cur.cutoff_jitter_g - m->cutoff_jitter_g) * inv_n;
+            float d_vca = (cur.vca - m->vca) * inv_n;
+            float d_bypass = (cur.bypass - m->bypass) * inv_n;
+            float *cutoff = sc->cutoff_g + start;
+
+            for (int j = 0; j < n; ++j) {
+                float t = (float)(j + 1);
+                sc->freq_hz[start + j] = m->freq_hz + d_freq * t;
+                sc->pwm[start + j] = m->pwm + d_pwm * t;
+                cutoff[j] = m->cutoff_g + d_cutoff * t;
+                sc->vca[start + j] = m->vca + d_vca * t;
+                sc->bypass[start + j] = m->bypass + d_bypass * t;
+                sc->self_amp[start + j] = self_amp_target;
+                sc->self_inc[start + j] = self_inc;
+            }
+            /* Per-sample cutoff jitter (see compute_mod_frame). */
+            if (m->cutoff_jitter_g != 0.0f || cur.cutoff_jitter_g != 0.0f) {
+                float *noise = sc->noise + start;
+                sh101_noise_block(&inst->noise[SH101_NOISE_JITTER], noise, n);
+                for (int j = 0; j < n; ++j) {
+                    float jitter_g = m->cutoff_jitter_g + d_jitter * (float)(j + 1);
+                    cutoff[j] += 0.5f * noise[j] * jitter_g;
+                }
             }
         }
 
-        float mw_shape = depth_curve(inst->mod_wheel);
-        float pitch_depth = depth_curve(inst->lfo_pitch) * (1.0f + 1.4f * mw_shape);
-        float filter_depth = depth_curve(inst->lfo_filter) * (1.0f + 1.2f * mw_shape);
-        float pwm_depth = clampf(inst->pwm_depth + inst->lfo_pwm, 0.0f, 1.0f);
-        float pwm_mod_depth = depth_curve(pwm_depth) * (1.0f + 0.6f * mw_shape);
+        inst->mod_prev = cur;
+        start += n;
+    }
+    return self_osc_active;
+}
 
-        float pitch_mod_st = lfo * pitch_depth * 0.85f;
-        if (inst->lfo_pitch_snap) {
-            pitch_mod_st = roundf(pitch_mod_st * 12.0f) / 12.0f;
+/* Stage 3: ladder filter and the high-cutoff bypass blend.  When
+   oversampling, the oscillator output is interpolated, filtered and blended
+   at the higher rate (coefficients held per host sample) and decimated. */
+static void render_filter_stage(sh101_instance_t *inst, int frames) {
+    sh101_scratch_t *sc = &inst->scratch;
+    int euler = (inst->filter_model == SH101_FILTER_EULER);
+    int factor = inst->oversampler.factor;
+
+    if (factor == 1) {
+        float *y = sc->filtered;
+        sh101_filter_process_block(&inst->filter, sc->osc, sc->cutoff_g, y, frames);
+        if (euler) {
+            for (int i = 0; i < frames; ++i) {
+                y[i] += (sc->osc[i] - y[i]) * sc->bypass[i];
+            }
         }
-        float bend_st = inst->pitch_bend * inst->pitch_bend_semitones;
-        float drift_st = inst->drift_st;
-        float fine_st = inst->fine_tune_cents / 100.0f;
-        float freq = inst->control.pitch_current_hz * powf(2.0f, (pitch_mod_st + bend_st + drift_st + fine_st) / 12.0f);
+        return;
+    }
 
-        float pwm_lfo = (inst->pwm_mode == 2) ? (lfo * pwm_mod_depth * 0.42f) : 0.0f;
-        float pwm_env = (inst->pwm_mode == 0) ? ((env_amp * 2.0f - 1.0f) * inst->pwm_env_depth * 0.45f) : 0.0f;
-        float pwm = clampf(inst->pulse_width + pwm_lfo + pwm_env, 0.05f, 0.95f);
-
-        float osc = sh101_osc_render(&inst->osc,
-                                     freq,
-                                     pwm,
-                                     inst->saw_level,
-                                     inst->pulse_level,
-                                     inst->sub_level,
-                                     inst->noise_level,
-                                     inst->sub_mode,
-                                     inst->white_noise
-                                         ? (inst->cutoff < 0.85f ? 0.85f : 1.0f)
-                                         : 0.0f);
-
-        int note_for_filter = (inst->control.current_note < 0) ? 60 : inst->control.current_note;
-        float env_delta = inst->env_amount * env_filt;
-        if (inst->filter_env_full_range && !inst->filter_env_polarity)
-            env_delta *= 2.0f;
-        if (inst->filter_env_polarity) env_delta = -env_delta;
-        float cutoff_raw = inst->cutoff
-                         + env_delta
-                         + (inst->filter_velocity_gain - 1.0f) * 0.6f
-                         + lfo * filter_depth * 0.50f;
-        float cutoff = clampf(cutoff_raw, 0.0f, 1.0f);
-
-        /* Per-sample cutoff noise models analog component drift — reduces
-           autocorrelation to match TAL's built-in analog modeling (~0.4-0.5 vs our 0.95+).
-           When the oscillator already carries noise, the cutoff jitter is reduced to
-           avoid double-randomizing the signal (which would push autocorr too low). */
-        float noise_atten = 1.0f - inst->noise_level * 0.75f;
-        float cutoff_noise = (rand_unit(&inst->drift_rng) - 0.5f) * 0.025f * noise_atten;
-        float cutoff_hz = note_to_cutoff_hz(note_for_filter, cutoff + cutoff_noise, inst->key_follow);
-        sh101_filter_set_params(&inst->filter, cutoff_hz, inst->resonance, 1.3f);
-
-        float filtered = sh101_filter_process(&inst->filter, osc);
-        /* Filter transparency: our Euler-integration 4-pole filter caps g at
-           0.35, making it opaque above ~2.5 kHz even at max cutoff.  The real
-           CEM3320 is essentially transparent at max cutoff.  Blend in the raw
-           oscillator signal at high cutoff to restore high-frequency content
-           (especially broadband noise that the filter otherwise removes). */
-        if (cutoff > 0.85f) {
-            /* Base bypass ramps up to 50% at max cutoff.  When noise is a
-               significant part of the oscillator mix, the bypass increases
-               further (up to 85%) because the filter's g cap removes more
-               high-frequency noise than the real CEM3320 would. */
-            float osc_total = inst->saw_level + inst->pulse_level
-                            + inst->sub_level + inst->noise_level;
-            float noise_share = (osc_total > 0.01f)
-                              ? (inst->noise_level / osc_total) : 0.0f;
-            float cutoff_ramp = clampf((cutoff - 0.85f) * 6.67f, 0.0f, 1.0f);
-            float max_bypass = 0.85f + noise_share * 0.12f;
-            float bypass = clampf(0.50f * cutoff_ramp
-                                + noise_share * 0.80f * cutoff_ramp,
-                                  0.0f, max_bypass);
-            filtered = filtered * (1.0f - bypass) + osc * bypass;
+    sh101_oversampler_up(&inst->oversampler, sc->osc, sc->os_in, frames);
+    for (int i = 0; i < frames; ++i) {
+        for (int j = 0; j < factor; ++j) sc->os_g[i * factor + j] = sc->cutoff_g[i];
+    }
+    sh101_filter_process_block(&inst->filter, sc->os_in, sc->os_g, sc->os_out, frames * factor);
+    if (euler) {
+        for (int i = 0; i < frames; ++i) {
+            float b = sc->bypass[i];
+            for (int j = i * factor; j < (i + 1) * factor; ++j) {
+                sc->os_out[j] += (sc->os_in[j] - sc->os_out[j]) * b;
+            }
         }
-        /* Synthetic self-oscillation for presets with no oscillator signal and
-           high resonance.  Models the CEM3320 ladder filter's natural tendency
-           to self-oscillate at the resonant frequency.  The build-up speed is
-           cutoff-dependent: low cutoff = slow energy circulation in the filter
-           loop = slow build-up, matching TAL's behavior (50-200ms). */
-        {
-            float self_osc_sig = 0.0f;
-            float self_amp_target = 0.0f;
-            if (fmaxf(env_amp, env_filt) > 0.01f &&
-                (inst->saw_level + inst->pulse_level + inst->sub_level + inst->noise_level) < 0.0005f &&
-                inst->resonance > 1.02f) {
-                float res_drive = clampf((inst->resonance - 1.0f) / 0.20f, 0.0f, 1.0f);
-                /* Self-osc amplitude rises with cutoff — matches analog filter
-                   where higher cutoff = more energy in the feedback loop. */
-                float cutoff_amp = clampf(cutoff * 0.80f, 0.0f, 0.60f);
-                /* Suppress for extreme cutoff overshoot (beyond Nyquist). */
-                if (cutoff_raw > 1.4f) {
-                    float lfo_swing = filter_depth * 0.50f;
-                    float rolloff = clampf((1.8f - cutoff_raw) / 0.4f, 0.0f, 1.0f);
-                    float lfo_sustain = clampf(lfo_swing * 5.0f, 0.0f, 1.0f);
-                    cutoff_amp *= fmaxf(rolloff, lfo_sustain);
+    }
+    sh101_oversampler_down(&inst->oversampler, sc->os_out, sc->filtered, frames);
+}
+
+/* Volume correction and Euler-integration loss compensation: each filter
+   stage loses energy per sample proportional to g, making the resonant peak
+   weaker than the analog CEM3320/IR3109 at high Q.  Apply a makeup gain
+   that increases with both resonance (more loss at higher Q) and cutoff
+   (higher g = more loss per stage).  The cutoff scaling keeps low-cutoff
+   presets (fully closed filter) from getting over-boosted. */
+static float makeup_gain(const sh101_instance_t *inst) {
+    float post_gain = 1.0f + inst->filter_volume_correction * inst->resonance * 0.45f;
+    if (inst->filter_model == SH101_FILTER_EULER && inst->resonance > 0.9f) {
+        float res_factor = clampf((inst->resonance - 0.9f) / 0.3f, 0.0f, 1.0f);
+        post_gain *= 1.0f + res_factor * (0.5f + inst->cutoff * 2.0f);
+    }
+    return post_gain;
+}
+
+/* Stage 4: self-oscillation, noise leak, makeup gain and DC block. */
+static void render_post_stage(sh101_instance_t *inst, int frames, int self_osc_active) {
+    sh101_scratch_t *sc = &inst->scratch;
+    float *y = sc->filtered;
+
+    {
+        /* Cutoff-dependent ramp speed: low base cutoff = slow energy
+           circulation in the filter loop = slow build-up.  Voiced per
+           sample at 44.1 kHz. */
+        float ramp_speed = 1.0f - sh101_fast_powf(1.0f - (0.0003f + inst->cutoff * 0.003f),
+                                                  inst->tuning_ratio);
+        if (self_osc_active) {
+            float chaos = self_osc_chaos(inst);
+            float *tone = sc->self_tone;
+            float c = inst->self_osc_cos;
+            float s = inst->self_osc_sin;
+            /* Coupled-form rotation: four multiplies per sample, with the
+               coefficients rebuilt only when the tick's increment changes. */
+            for (int i = 0; i < frames; ++i) {
+                float inc = sc->self_inc[i];
+                if (inc > 0.0f) {
+                    float rc, rs, c1;
+                    if (inc != inst->self_osc_inc) {
+                        inst->self_osc_inc = inc;
+                        inst->self_osc_rot_cos = sh101_fast_sin2pif(inc + 0.25f);
+                        inst->self_osc_rot_sin = sh101_fast_sin2pif(inc);
+                    }
+                    rc = inst->self_osc_rot_cos;
+                    rs = inst->self_osc_rot_sin;
+                    c1 = c * rc - s * rs;
+                    s = c * rs + s * rc;
+                    c = c1;
                 }
-                /* Self-oscillation character: analog filter resonance produces
-                   a clean sinusoid.  Noise is added only by specific modulators:
-                   - NOISE LFO wf (per-sample random cutoff → chaotic)
-                   - Fullrange bipolar envelope (extreme cutoff swings)
-                   - Large envelope sweeps (rapid FM → mildly chaotic) */
-                float chaos = 0.04f;
-                if (inst->lfo_waveform == SH101_LFO_WAVE_NOISE)
-                    chaos += inst->lfo_filter * 0.50f;
-                if (inst->filter_env_full_range)
-                    chaos += 0.35f;
-                chaos += inst->env_amount * inst->env_amount * 0.42f;
-                chaos = clampf(chaos, 0.0f, 0.80f);
-                float note_hz = sh101_midi_note_to_hz(note_for_filter);
-                float self_freq = note_hz * powf(2.0f, (cutoff - 0.45f) * 2.6f);
-                self_freq = clampf(self_freq, 20.0f, 8000.0f);
-                inst->self_osc_phase += clampf(self_freq / inst->control.sample_rate, 0.0f, 0.45f);
-                if (inst->self_osc_phase >= 1.0f) inst->self_osc_phase -= floorf(inst->self_osc_phase);
-                float tone = sinf(inst->self_osc_phase * 6.28318530718f);
-                float noise = rand_unit(&inst->drift_rng) * 2.0f - 1.0f;
-                self_osc_sig = tone * (1.0f - chaos) + noise * chaos;
-                /* Envelope sweep suppression: when a non-fullrange envelope
-                   sweeps the cutoff WITHOUT chaotic modulation (no LFO filter
-                   mod, low chaos), the smooth cutoff change disrupts the filter
-                   feedback loop — it can't build coherent self-oscillation.
-                   Presets with NOISE LFO, high LFO filter mod, or fullrange env
-                   create chaotic oscillation that persists through sweeps. */
-                float env_suppress = 1.0f;
-                if (chaos < 0.25f && !inst->filter_env_full_range
-                    && inst->lfo_filter < 0.1f) {
-                    env_suppress = clampf(1.0f - inst->env_amount * inst->env_amount * 3.0f,
-                                          0.0f, 1.0f);
+                tone[i] = s;
+            }
+            /* One Newton step toward unit radius cancels the drift from
+               rounding and the approximate rotation coefficients. */
+            {
+                float g = 1.5f - 0.5f * (c * c + s * s);
+                inst->self_osc_cos = c * g;
+                inst->self_osc_sin = s * g;
+            }
+            sh101_noise_block(&inst->noise[SH101_NOISE_CHAOS], sc->noise, frames);
+            for (int i = 0; i < frames; ++i) {
+                float self_osc_sig = 0.0f;
+                if (sc->self_inc[i] > 0.0f) {
+                    self_osc_sig = tone[i] * (1.0f - chaos) + sc->noise[i] * chaos;
                 }
-                self_amp_target = cutoff_amp * res_drive * env_suppress;
+                inst->self_osc_level += (sc->self_amp[i] - inst->self_osc_level) * ramp_speed;
+                y[i] += self_osc_sig * inst->self_osc_level;
             }
-            /* Cutoff-dependent ramp speed: low base cutoff = slow energy
-               circulation in the filter loop = slow build-up. */
-            float ramp_speed = 0.0003f + inst->cutoff * 0.003f;
-            inst->self_osc_level += (self_amp_target - inst->self_osc_level) * ramp_speed;
-            filtered += self_osc_sig * inst->self_osc_level;
-        }
-        /* CEM3320/IR3109 filters have a wider passband at high Q than a pure Moog
-           ladder — broadband noise leaks around the resonant peak.  Simulate this by
-           mixing a small amount of unfiltered noise past the filter, scaled by both
-           noise level and resonance above 0.8. */
-        if (inst->noise_level > 0.001f && inst->resonance > 0.8f) {
-            float leak_scale = inst->noise_level * 0.10f
-                             * clampf((inst->resonance - 0.8f) * 2.5f, 0.0f, 1.0f);
-            float leak_noise = (rand_unit(&inst->drift_rng) * 2.0f - 1.0f) * leak_scale;
-            filtered += leak_noise;
+        } else {
+            /* Nothing to add: only the level keeps decaying toward zero. */
+            inst->self_osc_level *= sh101_fast_powf(1.0f - ramp_speed, (float)frames);
         }
-        filtered *= 1.0f + inst->filter_volume_correction * inst->resonance * 0.45f;
-        /* Euler-integration loss compensation: each filter stage loses
-           energy per sample proportional to g, making the resonant peak
-           weaker than the analog CEM3320/IR3109 at high Q.  Apply a
-           makeup gain that increases with both resonance (more loss at
-           higher Q) and cutoff (higher g = more loss per stage).  The
-           cutoff scaling keeps low-cutoff presets (fully closed filter)
-           from getting over-boosted. */
-        if (inst->resonance > 0.9f) {
-            float res_factor = clampf((inst->resonance - 0.9f) / 0.3f, 0.0f, 1.0f);
-            float res_boost = 1.0f + res_factor * (0.5f + inst->cutoff * 2.0f);
-            filtered *= res_boost;
+    }
+
+    /* CEM3320/IR3109 filters have a wider passband at high Q than a pure Moog
+       ladder — broadband noise leaks around the resonant peak.  Simulate this by
+       mixing a small amount of unfiltered noise past the filter, scaled by both
+       noise level and resonance above 0.8. */
+    if (inst->noise_level > 0.001f && inst->resonance > 0.8f) {
+        float leak_scale = inst->noise_level * 0.10f
+                         * clampf((inst->resonance - 0.8f) * 2.5f, 0.0f, 1.0f);
+        sh101_noise_block(&inst->noise[SH101_NOISE_LEAK], sc->noise, frames);
+        for (int i = 0; i < frames; ++i) {
+            y[i] += sc->noise[i] * leak_scale;
         }
+    }
+
+    {
+        float post_gain = makeup_gain(inst);
         /* DC-blocking highpass (~0.35 Hz) models the coupling capacitor between
            the VCF output and the VCA input.  Removes pulse-wave DC offset that
            would otherwise pass through the lowpass filter and inflate the signal
            level at extreme PWM duty cycles.  The very low cutoff (~450ms time
            constant) ensures transient/percussive sounds are unaffected. */
-        {
-            inst->dc_block += (filtered - inst->dc_block) * 0.00005f;
-            filtered -= inst->dc_block;
+        float dc = inst->dc_block;
+        float dc_coef = inst->dc_coef;
+        for (int i = 0; i < frames; ++i) {
+            float v = y[i] * post_gain;
+            dc += (v - dc) * dc_coef;
+            y[i] = (v - dc) * sc->vca[i];
+        }
+        inst->dc_block = dc;
+    }
+}
+
+/* Poly mode's control tick: the shared modulation (LFO, bend, drift, fine
+   tune) is evaluated once, then each sounding voice advances its envelopes
+   and sets its ramp targets.  The mono modulation math is reused term for
+   term, with the voice's own envelopes, velocity gains and key follow. */
+static void compute_poly_tick(sh101_instance_t *inst, int start, int frames) {
+    const sh101_scratch_t *sc = &inst->scratch;
+    sh101_poly_t *p = &inst->poly;
+    float lfo = sc->lfo[start + frames - 1];
+    float inv_sr = 1.0f / inst->control.sample_rate;
+
+    advance_drift(inst);
+
+    float pitch_mod_st = lfo * inst->lfo_pitch_depth * 0.85f;
+    if (inst->lfo_pitch_snap) {
+        pitch_mod_st = roundf(pitch_mod_st * 12.0f) / 12.0f;
+    }
+    float shared_st = pitch_mod_st
+                    + inst->pitch_bend * inst->pitch_bend_semitones
+                    + inst->drift_st
+                    + inst->fine_tune_cents / 100.0f;
+    float pwm_lfo = (inst->pwm_mode == 2) ? (lfo * inst->lfo_pwm_depth * 0.42f) : 0.0f;
+    float cutoff_base = inst->cutoff + lfo * inst->lfo_filter_depth * 0.50f;
+    int vca_gate = (inst->vca_mode == SH101_VCA_MODE_GATE);
+
+    for (int v = 0; v < SH101_POLY_MAX_VOICES; ++v) {
+        if (!sh101_poly_voice_active(p, v)) continue;
+
+        float env_amp = sh101_env_advance_state(&inst->amp_env, &p->amp_value[v], &p->amp_stage[v],
+                                                1.0f, frames);
+        float env_filt = sh101_env_advance_state(&inst->filt_env, &p->filt_value[v], &p->filt_stage[v],
+                                                 1.0f, frames);
+
+        float vca_amp = vca_gate ? (p->gate[v] ? 1.0f : 0.0f) : env_amp;
+        p->vca_to[v] = vca_amp * p->amp_gain[v] * inst->output_level;
+
+        float freq_hz = sh101_pitch_st_to_hz(p->pitch_st[v] + shared_st);
+        p->inc_to[v] = clampf(freq_hz * inv_sr, 0.0f, 0.45f);
+
+        float pwm_env = (inst->pwm_mode == 0) ? ((env_amp * 2.0f - 1.0f) * inst->pwm_env_depth * 0.45f) : 0.0f;
+        p->pwm_to[v] = clampf(inst->pulse_width + pwm_lfo + pwm_env, 0.05f, 0.95f);
+
+        float env_delta = inst->env_amount * env_filt;
+        if (inst->filter_env_full_range && !inst->filter_env_polarity)
+            env_delta *= 2.0f;
+        if (inst->filter_env_polarity) env_delta = -env_delta;
+        float cutoff = clampf(cutoff_base + env_delta + (p->filt_gain[v] - 1.0f) * 0.6f, 0.0f, 1.0f);
+        float cutoff_hz = clampf((30.0f + cutoff * cutoff * 15000.0f) * p->follow[v], 20.0f, 18000.0f);
+        p->g_to[v] = sh101_filter_stage_gain(&p->ladder, sh101_filter_cutoff_to_g(&p->ladder, cutoff_hz));
+        p->bypass_to[v] = filter_bypass(inst, cutoff);
+
+        if (p->fresh[v]) {
+            /* A voice starting from silence has no previous tick to ramp
+               from; its VCA still ramps up from zero. */
+            p->inc[v] = p->inc_to[v];
+            p->pwm[v] = p->pwm_to[v];
+            p->g[v] = p->g_to[v];
+            p->bypass[v] = p->bypass_to[v];
+            p->fresh[v] = 0;
+        }
+    }
+}
+
+/* Poly mode render: the pool mixes its voices into the scratch buffer a
+   control tick at a time.  Glide, the synthetic self-oscillation, the noise
+   leak, cutoff jitter, the LFO gate mode, oversampling and the ladder's
+   ADAA belong to the mono voice and are not modelled per voice (see
+   README.md). */
+static void render_poly(sh101_instance_t *inst, int16_t *out_lr, int frames) {
+    sh101_scratch_t *sc = &inst->scratch;
+    sh101_poly_t *p = &inst->poly;
+    sh101_poly_patch_t patch;
+
+    patch.saw_mix = inst->saw_level;
+    patch.pulse_mix = inst->pulse_level;
+    patch.sub_mix = inst->sub_level;
+    patch.noise_mix = inst->noise_level;
+    patch.noise_color = inst->white_noise ? (inst->cutoff < 0.85f ? 0.85f : 1.0f) : 0.0f;
+    patch.noise_lp_a = inst->osc.noise_lp_a;
+    patch.sub_mode = inst->sub_mode;
+    patch.band_limited = inst->osc.band_limited;
+    patch.adaa = inst->osc.adaa;
+    patch.makeup_gain = makeup_gain(inst);
+    patch.dc_coef = inst->dc_coef;
+    sh101_filter_set_params(&p->ladder, p->ladder.cutoff_hz, inst->resonance, 1.3f);
+
+    for (int done = 0; done < frames; ) {
+        int n = frames - done;
+        if (n > SH101_RENDER_CHUNK) n = SH101_RENDER_CHUNK;
+
+        sh101_lfo_render_block(&inst->lfo, sc->lfo, n, NULL);
+        memset(sc->filtered, 0, (size_t)n * sizeof(float));
+        for (int start = 0; start < n; ) {
+            int t = n - start;
+            if (t > inst->control_rate) t = inst->control_rate;
+            compute_poly_tick(inst, start, t);
+            sh101_poly_render(p, &patch, SH101_POLY_MAX_VOICES, sc->filtered + start, t);
+            start += t;
+        }
+
+        sh101_s16_stereo_block(sc->filtered, out_lr + done * 2, n, inst->output_mix);
+        done += n;
+    }
+}
+
+/* True while nothing can reach the output: no gate, both envelopes idle and
+   the VCA ramp fully closed.  Only a note-on can change that (the LFO gate
+   mode also needs a held key).  In poly mode, no voice of the pool is
+   active. */
+static int voice_is_silent(const sh101_instance_t *inst) {
+    if (inst->polymode) {
+        for (int v = 0; v < SH101_POLY_MAX_VOICES; ++v) {
+            if (sh101_poly_voice_active(&inst->poly, v)) return 0;
         }
-        float amp = filtered * vca_amp * inst->velocity_gain * inst->output_level;
-        amp = clampf(amp, -1.0f, 1.0f);
+        return 1;
+    }
+    return !inst->control.gate &&
+           inst->amp_env.stage == ENV_IDLE &&
+           inst->filt_env.stage == ENV_IDLE &&
+           inst->mod_valid && inst->mod_prev.vca == 0.0f;
+}
+
+/* Idle: only the free-running modulation moves, tick for tick as
+   render_mod_stage would advance it.  Oscillator, filter and DC blocker
+   hold their state. */
+static void render_idle(sh101_instance_t *inst, int frames) {
+    for (int done = 0; done < frames; ) {
+        int n = frames - done;
+        if (n > SH101_RENDER_CHUNK) n = SH101_RENDER_CHUNK;
+        sh101_lfo_render_block(&inst->lfo, inst->scratch.lfo, n, NULL);
+        for (int start = 0; start < n; ) {
+            int t = n - start;
+            if (t > inst->control_rate) t = inst->control_rate;
+            advance_drift(inst);
+            sh101_control_advance_pitch(&inst->control, t);
+            start += t;
+        }
+        done += n;
+    }
+}
+
+/* Zeroes recursive state that has decayed below SH101_FLUSH_TINY, so long
+   release tails never reach subnormal values. */
+static void flush_denormal_state(sh101_instance_t *inst) {
+    sh101_filter_flush_denormals(&inst->filter);
+    inst->dc_block = sh101_flush_tiny(inst->dc_block);
+    inst->self_osc_level = sh101_flush_tiny(inst->self_osc_level);
+    inst->osc.noise_lp = sh101_flush_tiny(inst->osc.noise_lp);
+    inst->osc.sat_prev = sh101_flush_tiny(inst->osc.sat_prev);
+    inst->amp_env.value = sh101_flush_tiny(inst->amp_env.value);
+    inst->filt_env.value = sh101_flush_tiny(inst->filt_env.value);
+    sh101_poly_flush_denormals(&inst->poly);
+}
+
+static void render_voice(sh101_instance_t *inst, int16_t *out_lr, int frames) {
+    sync_derived(inst);
+    if (voice_is_silent(inst)) {
+        if (!inst->idle && inst->silent_frames >= inst->idle_holdoff) {
+            inst->idle = 1;
+            inst->self_osc_level = 0.0f;
+        }
+        inst->silent_frames += (inst->silent_frames < inst->idle_holdoff) ? frames : 0;
+    } else {
+        inst->idle = 0;
+        inst->silent_frames = 0;
+    }
+    if (inst->idle) {
+        render_idle(inst, frames);
+        if (!inst->output_mix) memset(out_lr, 0, (size_t)frames * 2 * sizeof(int16_t));
+        return;
+    }
+    if (inst->polymode) {
+        render_poly(inst, out_lr, frames);
+        return;
+    }
+
+    sh101_scratch_t *sc = &inst->scratch;
+    float white_color = inst->white_noise ? (inst->cutoff < 0.85f ? 0.85f : 1.0f) : 0.0f;
+    sh101_filter_set_params(&inst->filter, inst->filter.cutoff_hz, inst->resonance, 1.3f);
+
+    for (int done = 0; done < frames; ) {
+        int n = frames - done;
+        if (n > SH101_RENDER_CHUNK) n = SH101_RENDER_CHUNK;
+
+        int self_osc_active = render_mod_stage(inst, n);
+        sh101_osc_render_block(&inst->osc, sc->freq_hz, sc->pwm,
+                               inst->saw_level, inst->pulse_level, inst->sub_level, inst->noise_level,
+                               inst->sub_mode, white_color, sc->osc, n);
+        render_filter_stage(inst, n);
+        render_post_stage(inst, n, self_osc_active);
 
-        int16_t s = (int16_t)(amp * 32767.0f);
-        out_lr[i * 2] = s;
-        out_lr[i * 2 + 1] = s;
+        sh101_s16_stereo_block(sc->filtered, out_lr + done * 2, n, inst->output_mix);
+        done += n;
     }
 }
 
+/* Auto quality: adds the block's render time to the process-wide meter,
+   then scores the last whole host callback against the real-time deadline
+   and moves the active tier (applied by sync_derived before the next
+   block).  Every instance feeds the meter, so a set of instances that each
+   use a modest share of the deadline still steps down together when their
+   sum overruns.  An idle block says nothing about the voice's cost and is
+   not scored, but its time still counts towards the callback. */
+static void track_deadline(sh101_instance_t *inst, int frames, uint64_t elapsed_ns) {
+    float deadline_ns = (float)frames * 1e9f / inst->control.sample_rate;
+    float load;
+
+    sh101_quality_meter_add(&g_meter, &inst->meter_round, elapsed_ns);
+    if (!inst->quality_auto || inst->idle) return;
+    load = (float)g_meter.last_ns / deadline_ns;
+
+    if (sh101_quality_track(&inst->quality, load, frames, inst->control.sample_rate)) {
+        inst->dirty |= SH101_DIRTY_QUALITY;
+    }
+}
+
+/* The voice renders into the float scratch buffers and converts once per
+   chunk.  With output_target "Host Output" the instance writes to
+   mapped_memory + audio_out_offset and ignores out_lr, which may then be
+   NULL; with output_mode "Mix" on top, a chain of instances can share the
+   host output without a host-side mix pass.  The default, "Buffer", writes
+   only to out_lr. */
+static void v2_render_block(void *instance, int16_t *out_lr, int frames) {
+    sh101_instance_t *inst = (sh101_instance_t*)instance;
+    if (!inst || frames <= 0) return;
+    if (inst->output_host) {
+        if (!g_host || !g_host->mapped_memory) return;
+        out_lr = (int16_t*)(void*)(g_host->mapped_memory + g_host->audio_out_offset);
+    }
+    if (!out_lr) return;
+
+    uint64_t t0 = sh101_cpu_now_ns();
+
+    /* Flush-to-zero for the whole block, restored for the host. */
+    uint64_t fp_mode = sh101_cpu_ftz_enter();
+    render_voice(inst, out_lr, frames);
+    flush_denormal_state(inst);
+    sh101_cpu_ftz_leave(fp_mode);
+
+    track_deadline(inst, frames, sh101_cpu_now_ns() - t0);
+}
+
 static plugin_api_v2_t g_api = {
     .api_version = MOVE_PLUGIN_API_VERSION_2,
     .create_instance = v2_create_instance,
@@ -1720,5 +2615,6 @@ static plugin_api_v2_t g_api = {
 plugin_api_v2_t* move_plugin_init_v2(const host_api_v1_t *host) {
     g_host = host;
     sh101_log("init v2");
+    sh101_osc_set_isa(sh101_cpu_detect());
     return &g_api;
 }
@@ -0,0 +1,425 @@
+#include "sh101_poly.h"
+
+#include <string.h>
+
+#include "sh101_adaa.h"
+#include "sh101_fastmath.h"
+
+#if defined(__GNUC__)
+#define POLY_INLINE static inline __attribute__((always_inline))
+#else
+#define POLY_INLINE static inline
+#endif
+
+/* Samples per noise fill and lane-sum pass inside a render. */
+#define POLY_CHUNK 32
+
+/* Amplitude of the ZDF noise floor, as in sh101_filter.c. */
+#define POLY_ZDF_NOISE_FLOOR 1.0e-6f
+
+/* Four-lane vector ops for the voice kernel: one lane per voice. */
+#if defined(SH101_FASTMATH_NEON)
+
+typedef float32x4_t pv_t;
+typedef uint32x4_t pv_mask_t;
+
+POLY_INLINE pv_t pv_splat(float s) { return vdupq_n_f32(s); }
+POLY_INLINE pv_t pv_load(const float *p) { return vld1q_f32(p); }
+POLY_INLINE void pv_store(float *p, pv_t v) { vst1q_f32(p, v); }
+POLY_INLINE pv_t pv_add(pv_t a, pv_t b) { return vaddq_f32(a, b); }
+POLY_INLINE pv_t pv_sub(pv_t a, pv_t b) { return vsubq_f32(a, b); }
+POLY_INLINE pv_t pv_mul(pv_t a, pv_t b) { return vmulq_f32(a, b); }
+POLY_INLINE pv_t pv_div(pv_t a, pv_t b) { return vdivq_f32(a, b); }
+POLY_INLINE pv_t pv_max(pv_t a, pv_t b) { return vmaxq_f32(a, b); }
+POLY_INLINE pv_mask_t pv_ge(pv_t a, pv_t b) { return vcgeq_f32(a, b); }
+POLY_INLINE pv_mask_t pv_lt(pv_t a, pv_t b) { return vcltq_f32(a, b); }
+POLY_INLINE pv_mask_t pv_or(pv_mask_t a, pv_mask_t b) { return vorrq_u32(a, b); }
+POLY_INLINE pv_mask_t pv_andnot(pv_mask_t a, pv_mask_t b) { return vbicq_u32(a, b); }
+POLY_INLINE pv_t pv_select(pv_mask_t m, pv_t a, pv_t b) { return vbslq_f32(m, a, b); }
+POLY_INLINE pv_t pv_tanh(pv_t x) { return sh101_fast_tanhf_x4(x); }
+
+#elif defined(SH101_FASTMATH_SSE2)
+
+typedef __m128 pv_t;
+typedef __m128 pv_mask_t;
+
+POLY_INLINE pv_t pv_splat(float s) { return _mm_set1_ps(s); }
+POLY_INLINE pv_t pv_load(const float *p) { return _mm_load_ps(p); }
+POLY_INLINE void pv_store(float *p, pv_t v) { _mm_store_ps(p, v); }
+POLY_INLINE pv_t pv_add(pv_t a, pv_t b) { return _mm_add_ps(a, b); }
+POLY_INLINE pv_t pv_sub(pv_t a, pv_t b) { return _mm_sub_ps(a, b); }
+POLY_INLINE pv_t pv_mul(pv_t a, pv_t b) { return _mm_mul_ps(a, b); }
+POLY_INLINE pv_t pv_div(pv_t a, pv_t b) { return _mm_div_ps(a, b); }
+POLY_INLINE pv_t pv_max(pv_t a, pv_t b) { return _mm_max_ps(a, b); }
+POLY_INLINE pv_mask_t pv_ge(pv_t a, pv_t b) { return _mm_cmpge_ps(a, b); }
+POLY_INLINE pv_mask_t pv_lt(pv_t a, pv_t b) { return _mm_cmplt_ps(a, b); }
+POLY_INLINE pv_mask_t pv_or(pv_mask_t a, pv_mask_t b) { return _mm_or_ps(a, b); }
+POLY_INLINE pv_mask_t pv_andnot(pv_mask_t a, pv_mask_t b) { return _mm_andnot_ps(b, a); }
+POLY_INLINE pv_t pv_select(pv_mask_t m, pv_t a, pv_t b) {
+    return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+}
+POLY_INLINE pv_t pv_tanh(pv_t x) { return sh101_fast_tanhf_x4(x); }
+
+#else
+
+typedef struct { float v[4]; } pv_t;
+typedef struct { int v[4]; } pv_mask_t;
+
+#define PV_MAP(expr) do { for (int l_ = 0; l_ < 4; ++l_) r.v[l_] = (expr); } while (0)
+
+POLY_INLINE pv_t pv_splat(float s) { pv_t r; PV_MAP(s); return r; }
+POLY_INLINE pv_t pv_load(const float *p) { pv_t r; PV_MAP(p[l_]); return r; }
+POLY_INLINE void pv_store(float *p, pv_t v) { for (int l = 0; l < 4; ++l) p[l] = v.v[l]; }
+POLY_INLINE pv_t pv_add(pv_t a, pv_t b) { pv_t r; PV_MAP(a.v[l_] + b.v[l_]); return r; }
+POLY_INLINE pv_t pv_sub(pv_t a, pv_t b) { pv_t r; PV_MAP(a.v[l_] - b.v[l_]); return r; }
+POLY_INLINE pv_t pv_mul(pv_t a, pv_t b) { pv_t r; PV_MAP(a.v[l_] * b.v[l_]); return r; }
+POLY_INLINE pv_t pv_div(pv_t a, pv_t b) { pv_t r; PV_MAP(a.v[l_] / b.v[l_]); return r; }
+POLY_INLINE pv_t pv_max(pv_t a, pv_t b) { pv_t r; PV_MAP(a.v[l_] > b.v[l_] ? a.v[l_] : b.v[l_]); return r; }
+POLY_INLINE pv_mask_t pv_ge(pv_t a, pv_t b) { pv_mask_t r; PV_MAP(a.v[l_] >= b.v[l_]); return r; }
+POLY_INLINE pv_mask_t pv_lt(pv_t a, pv_t b) { pv_mask_t r; PV_MAP(a.v[l_] < b.v[l_]); return r; }
+POLY_INLINE pv_mask_t pv_or(pv_mask_t a, pv_mask_t b) { pv_mask_t r; PV_MAP(a.v[l_] | b.v[l_]); return r; }
+POLY_INLINE pv_mask_t pv_andnot(pv_mask_t a, pv_mask_t b) { pv_mask_t r; PV_MAP(a.v[l_] & !b.v[l_]); return r; }
+POLY_INLINE pv_t pv_select(pv_mask_t m, pv_t a, pv_t b) { pv_t r; PV_MAP(m.v[l_] ? a.v[l_] : b.v[l_]); return r; }
+POLY_INLINE pv_t pv_tanh(pv_t x) { pv_t r; PV_MAP(sh101_fast_tanhf(x.v[l_])); return r; }
+
+#undef PV_MAP
+
+#endif
+
+POLY_INLINE pv_t pv_fma(pv_t a, pv_t b, pv_t c) {
+    return pv_add(pv_mul(a, b), c);
+}
+
+void sh101_poly_init(sh101_poly_t *p, float sample_rate) {
+    memset(p, 0, sizeof(*p));
+    sh101_noise_seed(&p->noise, 0x504f4c59u);
+    sh101_filter_init(&p->ladder, sample_rate);
+    sh101_adaa_init();
+    sh101_poly_reset(p);
+}
+
+void sh101_poly_reset(sh101_poly_t *p) {
+    for (int v = 0; v < SH101_POLY_MAX_VOICES; ++v) {
+        p->acc[v] = 0.0f;
+        p->y1[v] = p->y2[v] = p->y3[v] = p->y4[v] = 0.0f;
+        p->noise_lp[v] = 0.0f;
+        p->dc[v] = 0.0f;
+        p->sat_prev[v] = 0.0f;
+        p->vca[v] = p->vca_to[v] = 0.0f;
+        p->amp_value[v] = p->filt_value[v] = 0.0f;
+        p->amp_stage[v] = p->filt_stage[v] = ENV_IDLE;
+        p->note[v] = -1;
+        p->gate[v] = 0;
+        p->fresh[v] = 1;
+        p->age[v] = 0;
+    }
+}
+
+int sh101_poly_voice_active(const sh101_poly_t *p, int v) {
+    return p->gate[v] || p->amp_stage[v] != ENV_IDLE || p->vca[v] != 0.0f;
+}
+
+static int pick_voice(const sh101_poly_t *p, int voices, int note) {
+    int quiet = -1;
+    int old = 0;
+
+    for (int v = 0; v < voices; ++v) {
+        if (p->note[v] == note && sh101_poly_voice_active(p, v)) return v;
+    }
+    for (int v = 0; v < voices; ++v) {
+        if (!sh101_poly_voice_active(p, v)) return v;
+    }
+    for (int v = 0; v < voices; ++v) {
+        if (!p->gate[v] && (quiet < 0 || p->amp_value[v] < p->amp_value[quiet])) quiet = v;
+        if (p->age[v] - p->age[old] > 0x80000000u) old = v;  /* older, wrap-safe */
+    }
+    return quiet >= 0 ? quiet : old;
+}
+
+int sh101_poly_note_on(sh101_poly_t *p, int voices, int note) {
+    int v = pick_voice(p, voices, note);
+    p->fresh[v] = !sh101_poly_voice_active(p, v);
+    p->note[v] = note;
+    p->gate[v] = 1;
+    p->age[v] = ++p->clock;
+    p->amp_stage[v] = ENV_ATTACK;
+    p->filt_stage[v] = ENV_ATTACK;
+    return v;
+}
+
+int sh101_poly_note_off(sh101_poly_t *p, int voices, int note) {
+    for (int v = 0; v < voices; ++v) {
+        if (p->gate[v] && p->note[v] == note) {
+            sh101_poly_gate_off(p, v);
+            return v;
+        }
+    }
+    return -1;
+}
+
+void sh101_poly_gate_off(sh101_poly_t *p, int v) {
+    p->gate[v] = 0;
+    p->amp_stage[v] = ENV_RELEASE;
+    p->filt_stage[v] = ENV_RELEASE;
+}
+
+/* Two-sample PolyBLEP weights for a step at phase wrap (see the scalar
+   version in sh101_osc.c). */
+POLY_INLINE void blep_x4(pv_t t, pv_t idt, pv_t *after, pv_t *before) {
+    pv_t zero = pv_splat(0.0f);
+    pv_t one = pv_splat(1.0f);
+    pv_t a = pv_max(pv_sub(one, pv_mul(t, idt)), zero);
+    pv_t b = pv_max(pv_fma(pv_sub(t, one), idt, one), zero);
+    *after = pv_mul(a, a);
+    *before = pv_mul(b, b);
+}
+
+/* Sub level in main cycle `w` (0-3) of the /4 count.  Low while: /2
+   square, odd cycles; /4 square, cycles 2-3; 25% /4 pulse, every cycle but
+   the first. */
+POLY_INLINE pv_t sub_x4(pv_t w, int sub_mode, pv_t lo, pv_t hi) {
+    pv_mask_t c1 = pv_ge(w, pv_splat(1.0f));
+    pv_mask_t c2 = pv_ge(w, pv_splat(2.0f));
+    pv_mask_t c3 = pv_ge(w, pv_splat(3.0f));
+    pv_mask_t low;
+    if (sub_mode == 1) low = c2;
+    else if (sub_mode == 2) low = c1;
+    else low = pv_or(pv_andnot(c1, c2), c3);
+    return pv_select(low, lo, hi);
+}
+
+/* w + k cycles, wrapped into [0, 4); 0 < k < 4. */
+POLY_INLINE pv_t cycle_add(pv_t w, float k) {
+    pv_t four = pv_splat(4.0f);
+    w = pv_add(w, pv_splat(k));
+    return pv_sub(w, pv_select(pv_ge(w, four), four, pv_splat(0.0f)));
+}
+
+/* One lane group for `frames` samples: oscillator, mixer and soft clip as
+   in sh101_osc_render_block, the ladder as in sh101_filter_process_block
+   without ADAA, then the bypass blend, makeup gain, DC blocker and VCA in
+   the mono voice's order.  Lane outputs are summed into `out`.  The phase
+   is a float count of main cycles rather than the mono voice's 32-bit
+   divider chain; its resolution is ample for audio-rate pitch. */
+POLY_INLINE void group_kernel(sh101_poly_t *p,
+                              int base,
+                              const sh101_poly_patch_t *patch,
+                              float *out,
+                              int frames,
+                              const int zdf,
+                              const int band_limited) {
+    SH101_POLY_ALIGNED float noise[POLY_CHUNK * SH101_POLY_LANES];
+    SH101_POLY_ALIGNED float lanes[POLY_CHUNK * SH101_POLY_LANES];
+    SH101_POLY_ALIGNED float clip[SH101_POLY_LANES];
+    int noise_on = patch->noise_mix != 0.0f;
+    const int adaa = patch->adaa;
+    float input_gain, feedback;
+    sh101_filter_ladder_coefs(&p->ladder, &input_gain, &feedback);
+
+    pv_t inv_n = pv_splat(1.0f / (float)frames);
+    pv_t inc = pv_load(p->inc + base);
+    pv_t pw = pv_load(p->pwm + base);
+    pv_t g = pv_load(p->g + base);
+    pv_t vca = pv_load(p->vca + base);
+    pv_t byp = pv_load(p->bypass + base);
+    pv_t d_inc = pv_mul(pv_sub(pv_load(p->inc_to + base), inc), inv_n);
+    pv_t d_pw = pv_mul(pv_sub(pv_load(p->pwm_to + base), pw), inv_n);
+    pv_t d_g = pv_mul(pv_sub(pv_load(p->g_to + base), g), inv_n);
+    pv_t d_vca = pv_mul(pv_sub(pv_load(p->vca_to + base), vca), inv_n);
+    pv_t d_byp = pv_mul(pv_sub(pv_load(p->bypass_to + base), byp), inv_n);
+
+    pv_t acc = pv_load(p->acc + base);
+    pv_t y1 = pv_load(p->y1 + base);
+    pv_t y2 = pv_load(p->y2 + base);
+    pv_t y3 = pv_load(p->y3 + base);
+    pv_t y4 = pv_load(p->y4 + base);
+    pv_t lp = pv_load(p->noise_lp + base);
+    pv_t dc = pv_load(p->dc + base);
+    pv_t sat_prev = pv_load(p->sat_prev + base);
+
+    pv_t zero = pv_splat(0.0f);
+    pv_t one = pv_splat(1.0f);
+    pv_t two = pv_splat(2.0f);
+    pv_t three = pv_splat(3.0f);
+    pv_t four = pv_splat(4.0f);
+    pv_t pulse_lo = pv_splat(-0.95f);
+    pv_t sub_lo = pv_splat(-1.0f);
+    pv_t sub_hi = pv_splat(patch->sub_mode == 2 ? 1.0f : 0.94f);
+    pv_t saw_mix = pv_splat(patch->saw_mix);
+    pv_t pulse_mix = pv_splat(patch->pulse_mix);
+    pv_t sub_mix = pv_splat(patch->sub_mix);
+    pv_t noise_mix = pv_splat(patch->noise_mix);
+    pv_t noise_a = pv_splat(patch->noise_lp_a);
+    pv_t noise_color = pv_splat(patch->noise_color);
+    pv_t mix_gain = pv_splat(0.42f * 1.4f);
+    pv_t in_gain = pv_splat(input_gain);
+    pv_t fb = pv_splat(feedback);
+    pv_t loop = pv_splat(1.5f * p->ladder.drive);
+    pv_t inc_min = pv_splat(1.0e-6f);
+    pv_t makeup = pv_splat(patch->makeup_gain);
+    pv_t dc_coef = pv_splat(patch->dc_coef);
+    pv_t floor_gain = pv_splat(POLY_ZDF_NOISE_FLOOR);
+
+    for (int i0 = 0; i0 < frames; i0 += POLY_CHUNK) {
+        int m = frames - i0;
+        if (m > POLY_CHUNK) m = POLY_CHUNK;
+        if (noise_on || zdf) sh101_noise_block(&p->noise, noise, m * SH101_POLY_LANES);
+
+        for (int j = 0; j < m; ++j) {
+            inc = pv_add(inc, d_inc);
+            pw = pv_add(pw, d_pw);
+            g = pv_add(g, d_g);
+            vca = pv_add(vca, d_vca);
+            byp = pv_add(byp, d_byp);
+
+            acc = pv_add(acc, inc);
+            acc = pv_sub(acc, pv_select(pv_ge(acc, four), four, zero));
+            pv_t whole = pv_add(pv_add(pv_select(pv_ge(acc, one), one, zero),
+                                       pv_select(pv_ge(acc, two), one, zero)),
+                                pv_select(pv_ge(acc, three), one, zero));
+            pv_t phase = pv_sub(acc, whole);
+            pv_t saw = pv_sub(pv_mul(phase, two), one);
+            pv_t sub = sub_x4(whole, patch->sub_mode, sub_lo, sub_hi);
+            pv_t pulse;
+            if (band_limited) {
+                pv_t idt = pv_div(one, pv_max(inc, inc_min));
+                pv_t after, before, after2, before2;
+                pv_t t2 = pv_sub(phase, pw);
+                t2 = pv_add(t2, pv_select(pv_lt(t2, zero), one, zero));
+                blep_x4(phase, idt, &after, &before);
+                blep_x4(t2, idt, &after2, &before2);
+                saw = pv_sub(saw, pv_sub(before, after));
+                pv_t saw2 = pv_sub(pv_sub(pv_mul(t2, two), one), pv_sub(before2, after2));
+                pulse = pv_fma(pv_splat(1.95f),
+                               pv_sub(pw, pv_mul(pv_sub(saw, saw2), pv_splat(0.5f))),
+                               pulse_lo);
+                /* Every sub edge falls on a main-phase wrap, so it takes the
+                   saw's weights, scaled by the step into or out of this
+                   cycle. */
+                pv_t h_after = pv_sub(sub, sub_x4(cycle_add(whole, 3.0f), patch->sub_mode, sub_lo, sub_hi));
+                pv_t h_before = pv_sub(sub_x4(cycle_add(whole, 1.0f), patch->sub_mode, sub_lo, sub_hi), sub);
+                sub = pv_fma(pv_sub(pv_mul(h_before, before), pv_mul(h_after, after)), pv_splat(0.5f), sub);
+            } else {
+                pulse = pv_select(pv_lt(phase, pw), one, pulse_lo);
+            }
+
+            pv_t mix = pv_fma(saw, saw_mix, pv_fma(pulse, pulse_mix, pv_mul(sub, sub_mix)));
+            if (noise_on) {
+                pv_t white = pv_load(noise + j * SH101_POLY_LANES);
+                lp = pv_fma(noise_a, pv_sub(white, lp), lp);
+                pv_t colored = pv_fma(pv_splat(0.72f), lp, pv_mul(pv_splat(0.28f), white));
+                pv_t n = pv_fma(pv_sub(white, colored), noise_color, colored);
+                mix = pv_fma(n, noise_mix, mix);
+            }
+            pv_t u = pv_mul(mix, mix_gain);
+            pv_t x;
+            if (adaa) {
+                pv_store(clip, u);
+                for (int l = 0; l < SH101_POLY_LANES; ++l) clip[l] = sh101_adaa_tanh(&p->sat_prev[base + l], clip[l]);
+                x = pv_load(clip);
+            } else {
+                x = pv_tanh(u);
+                sat_prev = u;
+            }
+
+            pv_t y;
+            if (zdf) {
+                x = pv_fma(pv_load(noise + j * SH101_POLY_LANES), floor_gain, x);
+                pv_t G2 = pv_mul(g, g);
+                pv_t S = pv_mul(pv_add(pv_add(pv_mul(pv_mul(G2, g), y1), pv_mul(G2, y2)),
+                                       pv_fma(g, y3, y4)),
+                                pv_sub(one, g));
+                pv_t den = pv_fma(pv_mul(loop, fb), pv_mul(G2, G2), one);
+                pv_t u = pv_div(pv_mul(loop, pv_sub(pv_mul(x, in_gain), pv_mul(fb, S))), den);
+                pv_t d;
+                u = pv_tanh(u);
+                d = pv_mul(pv_sub(u, y1), g); u = pv_add(d, y1); y1 = pv_add(u, d);
+                d = pv_mul(pv_sub(u, y2), g); u = pv_add(d, y2); y2 = pv_add(u, d);
+                d = pv_mul(pv_sub(u, y3), g); u = pv_add(d, y3); y3 = pv_add(u, d);
+                d = pv_mul(pv_sub(u, y4), g); u = pv_add(d, y4); y4 = pv_add(u, d);
+                y = u;
+            } else {
+                pv_t cubic = pv_splat(0.06f);
+                pv_t f = pv_mul(fb, pv_sub(y4, pv_mul(pv_splat(0.15f), y3)));
+                pv_t s = pv_tanh(pv_mul(pv_sub(pv_mul(x, in_gain), f), loop));
+                y1 = pv_fma(g, pv_sub(s, y1), y1);
+                y1 = pv_sub(y1, pv_mul(cubic, pv_mul(y1, pv_mul(y1, y1))));
+                y2 = pv_fma(g, pv_sub(y1, y2), y2);
+                y2 = pv_sub(y2, pv_mul(cubic, pv_mul(y2, pv_mul(y2, y2))));
+                y3 = pv_fma(g, pv_sub(y2, y3), y3);
+                y3 = pv_sub(y3, pv_mul(cubic, pv_mul(y3, pv_mul(y3, y3))));
+                y4 = pv_fma(g, pv_sub(y3, y4), y4);
+                y = pv_fma(pv_sub(x, y4), byp, y4);
+            }
+            y = pv_mul(y, makeup);
+            dc = pv_fma(pv_sub(y, dc), dc_coef, dc);
+            pv_store(lanes + j * SH101_POLY_LANES, pv_mul(pv_sub(y, dc), vca));
+        }
+
+        for (int j = 0; j < m; ++j) {
+            const float *l = lanes + j * SH101_POLY_LANES;
+            out[i0 + j] += (l[0] + l[1]) + (l[2] + l[3]);
+        }
+    }
+
+    pv_store(p->acc + base, acc);
+    pv_store(p->y1 + base, y1);
+    pv_store(p->y2 + base, y2);
+    pv_store(p->y3 + base, y3);
+    pv_store(p->y4 + base, y4);
+    pv_store(p->noise_lp + base, lp);
+    pv_store(p->dc + base, dc);
+    if (!adaa) pv_store(p->sat_prev + base, sat_prev);
+    /* The ramps end exactly on their targets. */
+    memcpy(p->inc + base, p->inc_to + base, SH101_POLY_LANES * sizeof(float));
+    memcpy(p->pwm + base, p->pwm_to + base, SH101_POLY_LANES * sizeof(float));
+    memcpy(p->g + base, p->g_to + base, SH101_POLY_LANES * sizeof(float));
+    memcpy(p->vca + base, p->vca_to + base, SH101_POLY_LANES * sizeof(float));
+    memcpy(p->bypass + base, p->bypass_to + base, SH101_POLY_LANES * sizeof(float));
+}
+
+static void group_euler(sh101_poly_t *p, int base, const sh101_poly_patch_t *patch, float *out, int frames) {
+    group_kernel(p, base, patch, out, frames, 0, 0);
+}
+
+static void group_euler_bl(sh101_poly_t *p, int base, const sh101_poly_patch_t *patch, float *out, int frames) {
+    group_kernel(p, base, patch, out, frames, 0, 1);
+}
+
+static void group_zdf(sh101_poly_t *p, int base, const sh101_poly_patch_t *patch, float *out, int frames) {
+    group_kernel(p, base, patch, out, frames, 1, 0);
+}
+
+static void group_zdf_bl(sh101_poly_t *p, int base, const sh101_poly_patch_t *patch, float *out, int frames) {
+    group_kernel(p, base, patch, out, frames, 1, 1);
+}
+
+void sh101_poly_render(sh101_poly_t *p, const sh101_poly_patch_t *patch, int voices, float *out, int frames) {
+    void (*kernel)(sh101_poly_t *, int, const sh101_poly_patch_t *, float *, int);
+    int zdf = (p->ladder.model == SH101_FILTER_ZDF);
+
+    if (frames <= 0) return;
+    if (zdf) kernel = patch->band_limited ? group_zdf_bl : group_zdf;
+    else kernel = patch->band_limited ? group_euler_bl : group_euler;
+
+    for (int base = 0; base < voices; base += SH101_POLY_LANES) {
+        int active = 0;
+        for (int v = base; v < base + SH101_POLY_LANES && v < voices; ++v) {
+            active |= sh101_poly_voice_active(p, v);
+        }
+        if (active) kernel(p, base, patch, out, frames);
+    }
+}
+
+void sh101_poly_flush_denormals(sh101_poly_t *p) {
+    for (int v = 0; v < SH101_POLY_MAX_VOICES; ++v) {
+        p->y1[v] = sh101_flush_tiny(p->y1[v]);
+        p->y2[v] = sh101_flush_tiny(p->y2[v]);
+        p->y3[v] = sh101_flush_tiny(p->y3[v]);
+        p->y4[v] = sh101_flush_tiny(p->y4[v]);
+        p->noise_lp[v] = sh101_flush_tiny(p->noise_lp[v]);
+        p->dc[v] = sh101_flush_tiny(p->dc[v]);
+        p->amp_value[v] = sh101_flush_tiny(p->amp_value[v]);
+        p->filt_value[v] = sh101_flush_tiny(p->filt_value[v]);
+    }
+}
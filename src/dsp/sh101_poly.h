@@ -0,0 +1,116 @@
+#ifndef SH101_POLY_H
+#define SH101_POLY_H
+
+#include <stdint.h>
+
+#include "sh101_env.h"
+#include "sh101_filter.h"
+#include "sh101_noise.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Polyphonic voice pool.  Per-voice state is stored as arrays indexed by
+   voice (struct of arrays), and the audio-rate kernel renders
+   SH101_POLY_LANES voices at once, one per SIMD lane.  A lane group with no
+   sounding voice is skipped, and voices are allocated lowest index first, so
+   a pool that is mostly idle costs little more than the voices it plays.
+
+   The pool owns the oscillators, ladders and VCAs.  Envelopes, pitch,
+   cutoff and VCA levels come from the caller, which sets the *_to targets
+   once per control tick before calling sh101_poly_render. */
+
+#define SH101_POLY_LANES 4
+#define SH101_POLY_MAX_VOICES 8
+#define SH101_POLY_ALIGNED _Alignas(16)
+
+/* Patch settings shared by every voice. */
+typedef struct {
+    float saw_mix;
+    float pulse_mix;
+    float sub_mix;
+    float noise_mix;
+    float noise_color;   /* see sh101_noise_colored_block */
+    float noise_lp_a;
+    int sub_mode;
+    int band_limited;    /* PolyBLEP saw, pulse and sub */
+    int adaa;            /* ADAA on the mixer soft clip (see sh101_osc_t) */
+    float makeup_gain;   /* applied to the ladder output ahead of the DC blocker */
+    float dc_coef;       /* DC blocker one-pole coefficient */
+} sh101_poly_patch_t;
+
+typedef struct {
+    /* Audio-rate state. */
+    SH101_POLY_ALIGNED float acc[SH101_POLY_MAX_VOICES];      /* oscillator position in main cycles, [0, 4);
+                                                                 the integer part drives the /2 and /4 subs */
+    SH101_POLY_ALIGNED float y1[SH101_POLY_MAX_VOICES];       /* ladder stages (Euler) or integrators (ZDF) */
+    SH101_POLY_ALIGNED float y2[SH101_POLY_MAX_VOICES];
+    SH101_POLY_ALIGNED float y3[SH101_POLY_MAX_VOICES];
+    SH101_POLY_ALIGNED float y4[SH101_POLY_MAX_VOICES];
+    SH101_POLY_ALIGNED float noise_lp[SH101_POLY_MAX_VOICES];
+    SH101_POLY_ALIGNED float dc[SH101_POLY_MAX_VOICES];       /* DC blocker ahead of the VCA */
+    SH101_POLY_ALIGNED float sat_prev[SH101_POLY_MAX_VOICES]; /* last mixer soft clip input, for ADAA */
+
+    /* Control-tick ramps: a render ramps linearly from these values to the
+       *_to targets and leaves the targets here. */
+    SH101_POLY_ALIGNED float inc[SH101_POLY_MAX_VOICES];      /* cycles per sample */
+    SH101_POLY_ALIGNED float pwm[SH101_POLY_MAX_VOICES];
+    SH101_POLY_ALIGNED float g[SH101_POLY_MAX_VOICES];        /* see sh101_filter_stage_gain */
+    SH101_POLY_ALIGNED float vca[SH101_POLY_MAX_VOICES];
+    SH101_POLY_ALIGNED float bypass[SH101_POLY_MAX_VOICES];   /* raw-oscillator blend (Euler) */
+    SH101_POLY_ALIGNED float inc_to[SH101_POLY_MAX_VOICES];
+    SH101_POLY_ALIGNED float pwm_to[SH101_POLY_MAX_VOICES];
+    SH101_POLY_ALIGNED float g_to[SH101_POLY_MAX_VOICES];
+    SH101_POLY_ALIGNED float vca_to[SH101_POLY_MAX_VOICES];
+    SH101_POLY_ALIGNED float bypass_to[SH101_POLY_MAX_VOICES];
+
+    /* Control state, kept by the caller's tick.  The envelopes share the
+       caller's ADSR (see sh101_env_advance_state). */
+    float amp_value[SH101_POLY_MAX_VOICES];
+    float filt_value[SH101_POLY_MAX_VOICES];
+    sh101_env_stage_t amp_stage[SH101_POLY_MAX_VOICES];
+    sh101_env_stage_t filt_stage[SH101_POLY_MAX_VOICES];
+    float pitch_st[SH101_POLY_MAX_VOICES];   /* note with transpose */
+    float velocity[SH101_POLY_MAX_VOICES];
+    float amp_gain[SH101_POLY_MAX_VOICES];   /* velocity response */
+    float filt_gain[SH101_POLY_MAX_VOICES];
+    float follow[SH101_POLY_MAX_VOICES];     /* cutoff key-follow ratio */
+
+    /* Allocation. */
+    int note[SH101_POLY_MAX_VOICES];         /* MIDI note, -1 = never played */
+    int gate[SH101_POLY_MAX_VOICES];
+    int fresh[SH101_POLY_MAX_VOICES];        /* 1 = was silent; next tick starts its ramps at the targets */
+    uint32_t age[SH101_POLY_MAX_VOICES];     /* allocation order */
+    uint32_t clock;
+
+    sh101_noise_t noise;    /* lane l of the stream feeds voice lane l, noise source and ZDF floor */
+    sh101_filter_t ladder;  /* model, resonance, drive and g range of every voice; its own state is unused */
+} sh101_poly_t;
+
+void sh101_poly_init(sh101_poly_t *p, float sample_rate);
+/* Silences every voice and clears its state. */
+void sh101_poly_reset(sh101_poly_t *p);
+/* Gated, enveloped, or still ramping its VCA down. */
+int sh101_poly_voice_active(const sh101_poly_t *p, int v);
+/* Picks a voice among the first `voices` for `note` and gates it on with
+   both envelopes in attack.  A voice already playing the note is reused;
+   otherwise the lowest silent voice; otherwise a voice is stolen, the
+   quietest released one first and the oldest held one if none is
+   released.  Returns the voice. */
+int sh101_poly_note_on(sh101_poly_t *p, int voices, int note);
+/* Releases the gated voice playing `note` among the first `voices`;
+   returns it, or -1. */
+int sh101_poly_note_off(sh101_poly_t *p, int voices, int note);
+void sh101_poly_gate_off(sh101_poly_t *p, int v);
+/* Adds `frames` samples of the first `voices` voices to `out`, ramping each
+   active voice from its current values to its targets. */
+void sh101_poly_render(sh101_poly_t *p, const sh101_poly_patch_t *patch, int voices, float *out, int frames);
+/* Zeroes decayed state (see SH101_FLUSH_TINY); call between blocks. */
+void sh101_poly_flush_denormals(sh101_poly_t *p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
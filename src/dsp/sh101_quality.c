@@ -0,0 +1,46 @@
+#include "sh101_quality.h"
+
+void sh101_quality_restart(sh101_quality_state_t *q, int chosen) {
+    q->chosen = chosen;
+    q->active = chosen;
+    q->overrun_score = 0;
+    q->calm_frames = 0;
+}
+
+int sh101_quality_track(sh101_quality_state_t *q, float load, int frames, float sample_rate) {
+    if (load > SH101_QUALITY_OVERRUN_LOAD) {
+        q->calm_frames = 0;
+        if (++q->overrun_score >= SH101_QUALITY_OVERRUN_BLOCKS) {
+            q->overrun_score = 0;
+            if (q->active > SH101_QUALITY_ECO) {
+                q->active -= 1;
+                return 1;
+            }
+        }
+        return 0;
+    }
+    if (q->overrun_score > 0) q->overrun_score -= 1;
+    if (load >= SH101_QUALITY_CALM_LOAD) {
+        q->calm_frames = 0;
+        return 0;
+    }
+    q->calm_frames += frames;
+    if (q->calm_frames >= (int)(SH101_QUALITY_CALM_S * sample_rate)) {
+        q->calm_frames = 0;
+        if (q->active < q->chosen) {
+            q->active += 1;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void sh101_quality_meter_add(sh101_quality_meter_t *m, uint32_t *seen, uint64_t ns) {
+    if (*seen == m->round) {
+        m->last_ns = m->spent_ns;
+        m->spent_ns = 0;
+        m->round += 1;
+    }
+    *seen = m->round;
+    m->spent_ns += ns;
+}
@@ -0,0 +1,59 @@
+#ifndef SH101_QUALITY_H
+#define SH101_QUALITY_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* CPU/fidelity tiers; the plugin's apply_quality maps them to settings. */
+typedef enum {
+    SH101_QUALITY_ECO = 0,
+    SH101_QUALITY_NORMAL = 1,
+    SH101_QUALITY_HIGH = 2
+} sh101_quality_t;
+
+/* Auto quality: a host callback whose render_blocks take more than
+   OVERRUN_LOAD of the block's real-time deadline counts as an overrun; a leaky count of
+   OVERRUN_BLOCKS steps the tier down.  CALM_S seconds of blocks under
+   CALM_LOAD step it back up.  The gap between the loads is the hysteresis. */
+#define SH101_QUALITY_OVERRUN_LOAD 0.75f
+#define SH101_QUALITY_OVERRUN_BLOCKS 8
+#define SH101_QUALITY_CALM_LOAD 0.30f
+#define SH101_QUALITY_CALM_S 2.0f
+
+typedef struct {
+    int chosen;         /* sh101_quality_t; auto mode never goes above it */
+    int active;         /* sh101_quality_t in effect */
+    int overrun_score;  /* leaky count of overrunning blocks */
+    int calm_frames;    /* frames rendered under SH101_QUALITY_CALM_LOAD in a row */
+} sh101_quality_state_t;
+
+/* Render time summed over every instance in the process, one round per
+   host callback.  The host renders each instance once per callback, so an
+   instance rendering a second time in a round means the callback is over.
+   Only time spent in this module is seen; other modules sharing the
+   callback are not. */
+typedef struct {
+    uint32_t round;       /* current round */
+    uint64_t spent_ns;    /* render time so far in the current round */
+    uint64_t last_ns;     /* render time of the last complete round */
+} sh101_quality_meter_t;
+
+/* Adds an instance's render time.  `seen` is the instance's own record of
+   the round it last added to; a new instance starts it at round - 1. */
+void sh101_quality_meter_add(sh101_quality_meter_t *m, uint32_t *seen, uint64_t ns);
+
+/* Starts over from `chosen`: it becomes the active tier and the scores
+   are cleared. */
+void sh101_quality_restart(sh101_quality_state_t *q, int chosen);
+/* Scores a block of `frames` that took `load` of its real-time deadline
+   and moves the active tier.  Returns 1 when the active tier changed. */
+int sh101_quality_track(sh101_quality_state_t *q, float load, int frames, float sample_rate);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -25,6 +25,9 @@ def render_tool(repo_root: Path) -> Path:
         "tools/render_osc_fixture.c",
         "src/dsp/sh101_osc.c",
         "src/dsp/sh101_filter.c",
+        "src/dsp/sh101_adaa.c",
+        "src/dsp/sh101_noise.c",
+        "src/dsp/sh101_cpu.c",
         "-lm",
         "-o",
         str(tool),
@@ -0,0 +1,148 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+
+#include "sh101_adaa.h"
+#include "sh101_filter.h"
+#include "sh101_osc.h"
+
+#define FRAMES 8192
+#define SR 44100.0f
+
+static double tone_power(const float *x, int n, double hz) {
+    double w = 2.0 * 3.141592653589793 * hz / (double)SR;
+    double c = 2.0 * cos(w);
+    double s1 = 0.0;
+    double s2 = 0.0;
+    for (int i = 0; i < n; ++i) {
+        double s0 = (double)x[i] + c * s1 - s2;
+        s2 = s1;
+        s1 = s0;
+    }
+    return s1 * s1 + s2 * s2 - c * s1 * s2;
+}
+
+/* ADAA quotients against the exact antiderivatives in double. */
+static void test_accuracy(void) {
+    uint32_t seed = 7u;
+    float max_tanh = 0.0f;
+    float max_cubic = 0.0f;
+    for (int i = 0; i < 200000; ++i) {
+        float u0, u1, p, y;
+        double ref;
+        seed = seed * 1664525u + 1013904223u;
+        u0 = (float)(seed >> 8) * (24.0f / 16777216.0f) - 12.0f;
+        seed = seed * 1664525u + 1013904223u;
+        /* Steps from 1e-6 to 1, both signs. */
+        u1 = u0 + (float)pow(10.0, -6.0 + 6.0 * (double)(seed >> 9) / 8388608.0) * ((seed & 1u) ? 1.0f : -1.0f);
+
+        if (fabs((double)u1 - u0) < 1e-9) {
+            ref = tanh(0.5 * ((double)u0 + u1));
+        } else {
+            ref = (log(cosh((double)u1)) - log(cosh((double)u0))) / ((double)u1 - u0);
+        }
+        p = u0;
+        y = sh101_adaa_tanh(&p, u1);
+        assert(p == u1);
+        if (fabsf(y - (float)ref) > max_tanh) max_tanh = fabsf(y - (float)ref);
+
+        if (fabs((double)u1 - u0) > 1e-3 && fabsf(u0) < 3.0f) {
+            double x0 = u0, x1 = u1;
+            double F0 = 0.5 * x0 * x0 - 0.015 * x0 * x0 * x0 * x0;
+            double F1 = 0.5 * x1 * x1 - 0.015 * x1 * x1 * x1 * x1;
+            p = u0;
+            y = sh101_adaa_cubic(&p, u1, 0.06f);
+            if (fabsf(y - (float)((F1 - F0) / (x1 - x0))) > max_cubic) {
+                max_cubic = fabsf(y - (float)((F1 - F0) / (x1 - x0)));
+            }
+        }
+    }
+    printf("max error: tanh %.2e, cubic %.2e\n", max_tanh, max_cubic);
+    assert(max_tanh < 2e-5f);
+    assert(max_cubic < 1e-5f);
+}
+
+/* A hard-driven 5 kHz sine: the 7th harmonic (35 kHz) folds to 9.1 kHz. */
+static void test_alias_reduction(void) {
+    static float plain[FRAMES];
+    static float adaa[FRAMES];
+    float prev = 0.0f;
+    double fund_p, fund_a, alias_p, alias_a;
+    for (int i = 0; i < FRAMES; ++i) {
+        float u = 6.0f * sinf(2.0f * 3.14159265f * 5000.0f * (float)i / SR);
+        plain[i] = sh101_fast_tanhf(u);
+        adaa[i] = u;
+    }
+    sh101_adaa_tanh_block(&prev, adaa, adaa, 1.0f, FRAMES);
+
+    fund_p = tone_power(plain, FRAMES, 5000.0);
+    fund_a = tone_power(adaa, FRAMES, 5000.0);
+    alias_p = 10.0 * log10(tone_power(plain, FRAMES, 9100.0) / fund_p);
+    alias_a = 10.0 * log10(tone_power(adaa, FRAMES, 9100.0) / fund_a);
+    printf("9.1 kHz alias: plain %.1f dB, adaa %.1f dB\n", alias_p, alias_a);
+    assert(alias_a < alias_p - 10.0);
+}
+
+static void test_filter_block_matches_scalar(void) {
+    static float in[FRAMES];
+    static float g[FRAMES];
+    static float ref[FRAMES];
+    static float out[FRAMES];
+    sh101_filter_t a;
+    sh101_filter_t b;
+    uint32_t seed = 3u;
+
+    sh101_filter_init(&a, SR);
+    a.adaa = 1;
+    sh101_filter_set_params(&a, 2000.0f, 0.9f, 2.0f);
+    b = a;
+    for (int i = 0; i < FRAMES; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        in[i] = (float)(seed >> 9) * (2.0f / 8388608.0f) - 1.0f;
+        g[i] = sh101_filter_cutoff_to_g(&a, 2000.0f);
+    }
+    for (int i = 0; i < FRAMES; ++i) ref[i] = sh101_filter_process(&a, in[i]);
+    sh101_filter_process_block(&b, in, g, out, FRAMES);
+    for (int i = 0; i < FRAMES; ++i) {
+        assert(fabsf(ref[i] - out[i]) < 1e-5f);
+        assert(isfinite(out[i]));
+    }
+}
+
+/* The mixer soft clip is plain tanh unless ADAA is switched on; block and
+   scalar renders agree either way. */
+static void test_osc_soft_clip_flag(void) {
+    static float freq[FRAMES];
+    static float pwm[FRAMES];
+    static float out[2][FRAMES];
+    int differ = 0;
+
+    for (int i = 0; i < FRAMES; ++i) {
+        freq[i] = 3000.0f;
+        pwm[i] = 0.5f;
+    }
+    for (int adaa = 0; adaa < 2; ++adaa) {
+        sh101_osc_t a;
+        sh101_osc_t b;
+        sh101_osc_init(&a, SR, 7u);
+        a.adaa = adaa;
+        b = a;
+        sh101_osc_render_block(&b, freq, pwm, 1.0f, 0.0f, 0.6f, 0.0f, 0, 0.0f, out[adaa], FRAMES);
+        for (int i = 0; i < FRAMES; ++i) {
+            float ref = sh101_osc_render(&a, freq[i], pwm[i], 1.0f, 0.0f, 0.6f, 0.0f, 0, 0.0f);
+            assert(fabsf(ref - out[adaa][i]) < 1e-5f);
+        }
+    }
+    for (int i = 0; i < FRAMES; ++i) differ += out[0][i] != out[1][i];
+    assert(differ > FRAMES / 2);
+}
+
+int main(void) {
+    sh101_adaa_init();
+    test_accuracy();
+    test_alias_reduction();
+    test_filter_block_matches_scalar();
+    test_osc_soft_clip_flag();
+    printf("ok\n");
+    return 0;
+}
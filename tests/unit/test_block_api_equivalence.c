@@ -0,0 +1,176 @@
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+
+#include "sh101_control.h"
+#include "sh101_env.h"
+#include "sh101_filter.h"
+#include "sh101_lfo.h"
+#include "sh101_osc.h"
+
+#define N 256
+
+/* Phases are integer, so the vector oscillator matches the scalar path
+   except for float rounding in the coloured-noise filter. */
+static void check_osc_block(void) {
+    float freq[N];
+    float pwm[N];
+    float out[N];
+    for (int i = 0; i < N; ++i) {
+        freq[i] = 110.0f + 37.0f * (float)i;
+        pwm[i] = 0.3f + 0.001f * (float)i;
+    }
+    for (int sub_mode = 0; sub_mode <= 2; ++sub_mode) {
+        sh101_osc_t a;
+        sh101_osc_t b;
+        sh101_osc_init(&a, 44100.0f, 77u);
+        sh101_osc_init(&b, 44100.0f, 77u);
+        for (int blk = 0; blk < 8; ++blk) {
+            int frames = N - 3 * blk;
+            sh101_osc_render_block(&b, freq, pwm, 0.5f, 0.6f, 0.7f, 0.2f, sub_mode, 0.5f, out, frames);
+            for (int i = 0; i < frames; ++i) {
+                float ref = sh101_osc_render(&a, freq[i], pwm[i], 0.5f, 0.6f, 0.7f, 0.2f, sub_mode, 0.5f);
+                assert(fabsf(ref - out[i]) < 1e-5f);
+            }
+        }
+        assert(a.phase == b.phase);
+        assert(memcmp(a.noise.lane, b.noise.lane, sizeof(a.noise.lane)) == 0);
+        assert(a.noise.pos == b.noise.pos);
+        assert(fabsf(a.noise_lp - b.noise_lp) < 1e-5f);
+    }
+}
+
+/* Every kernel variant the CPU supports renders bit-identical blocks. */
+static void check_osc_isa_variants(void) {
+    static const sh101_isa_t isas[] = {
+        SH101_ISA_SSE2, SH101_ISA_AVX2, SH101_ISA_NEON
+    };
+    float freq[N];
+    float pwm[N];
+    float ref[N];
+    float out[N];
+    for (int i = 0; i < N; ++i) {
+        freq[i] = 55.0f + 61.0f * (float)i;
+        pwm[i] = 0.2f + 0.002f * (float)i;
+    }
+    for (unsigned k = 0; k < sizeof(isas) / sizeof(isas[0]); ++k) {
+        if (!sh101_cpu_supports(isas[k])) continue;
+        for (int bl = 0; bl <= 1; ++bl) {
+            sh101_osc_t a;
+            sh101_osc_t b;
+            sh101_osc_init(&a, 44100.0f, 5u);
+            sh101_osc_init(&b, 44100.0f, 5u);
+            a.band_limited = bl;
+            b.band_limited = bl;
+            for (int blk = 0; blk < 6; ++blk) {
+                int frames = N - 5 * blk;
+                assert(sh101_osc_set_isa(SH101_ISA_SCALAR) == SH101_ISA_SCALAR);
+                sh101_osc_render_block(&a, freq, pwm, 0.5f, 0.6f, 0.7f, 0.2f, blk % 3, 0.5f, ref, frames);
+                assert(sh101_osc_set_isa(isas[k]) == isas[k]);
+                sh101_osc_render_block(&b, freq, pwm, 0.5f, 0.6f, 0.7f, 0.2f, blk % 3, 0.5f, out, frames);
+                assert(memcmp(ref, out, (size_t)frames * sizeof(float)) == 0);
+            }
+            assert(a.phase == b.phase);
+        }
+    }
+    sh101_osc_set_isa(sh101_cpu_detect());
+}
+
+static void check_filter_block(void) {
+    sh101_filter_t a;
+    sh101_filter_t b;
+    float in[N];
+    float cutoff[N];
+    float g[N];
+    float out[N];
+    sh101_filter_init(&a, 44100.0f);
+    sh101_filter_init(&b, 44100.0f);
+    sh101_filter_set_params(&b, 800.0f, 0.9f, 1.3f);
+    for (int i = 0; i < N; ++i) {
+        in[i] = (i % 64) < 32 ? 0.5f : -0.5f;
+        cutoff[i] = 300.0f + 10.0f * (float)i;
+        g[i] = sh101_filter_cutoff_to_g(&b, cutoff[i]);
+    }
+    sh101_filter_process_block(&b, in, g, out, N);
+    for (int i = 0; i < N; ++i) {
+        sh101_filter_set_params(&a, cutoff[i], 0.9f, 1.3f);
+        float ref = sh101_filter_process(&a, in[i]);
+        assert(fabsf(ref - out[i]) < 1e-5f);
+    }
+}
+
+static void check_env_lfo_pitch_blocks(void) {
+    sh101_env_t ea;
+    sh101_env_t eb;
+    sh101_lfo_t la;
+    sh101_lfo_t lb;
+    sh101_control_t ca;
+    sh101_control_t cb;
+    float out[N];
+
+    sh101_env_init(&ea, 44100.0f);
+    sh101_env_init(&eb, 44100.0f);
+    sh101_env_gate_on(&ea, 1.0f);
+    sh101_env_gate_on(&eb, 1.0f);
+    sh101_env_process_block(&eb, out, N);
+    for (int i = 0; i < N; ++i) assert(sh101_env_process(&ea) == out[i]);
+
+    /* Full ADSR cycle across block boundaries, including sustain and idle fills. */
+    sh101_env_set_adsr(&ea, 0.003f, 0.02f, 0.4f, 0.01f);
+    sh101_env_set_adsr(&eb, 0.003f, 0.02f, 0.4f, 0.01f);
+    for (int pass = 0; pass < 2; ++pass) {
+        if (pass == 1) {
+            sh101_env_gate_off(&ea);
+            sh101_env_gate_off(&eb);
+        }
+        for (int blk = 0; blk < 24; ++blk) {
+            sh101_env_process_block(&eb, out, N);
+            for (int i = 0; i < N; ++i) assert(sh101_env_process(&ea) == out[i]);
+        }
+    }
+    assert(eb.stage == ENV_IDLE);
+
+    sh101_lfo_init(&la, 44100.0f);
+    sh101_lfo_init(&lb, 44100.0f);
+    sh101_lfo_set_rate_hz(&la, 30.0f);
+    sh101_lfo_set_rate_hz(&lb, 30.0f);
+    sh101_lfo_process_block(&lb, out, N);
+    for (int i = 0; i < N; ++i) assert(sh101_lfo_process(&la) == out[i]);
+
+    for (int linear = 0; linear <= 1; ++linear) {
+        sh101_control_init(&ca, 44100.0f);
+        sh101_control_init(&cb, 44100.0f);
+        sh101_control_set_glide(&ca, 40.0f, linear);
+        sh101_control_set_glide(&cb, 40.0f, linear);
+        sh101_control_note_on(&ca, 60, 100);
+        sh101_control_note_on(&cb, 60, 100);
+        sh101_control_note_on(&ca, 72, 100);
+        sh101_control_note_on(&cb, 72, 100);
+        sh101_control_render_pitch_block(&cb, out, N);
+        for (int i = 0; i < N; ++i) {
+            sh101_control_tick_pitch(&ca);
+            assert(ca.pitch_current_hz == out[i]);
+        }
+    }
+
+    /* Cached glide coefficients follow direct writes to glide_ms. */
+    sh101_control_init(&ca, 44100.0f);
+    ca.glide_ms = 40.0f;
+    sh101_control_note_on(&ca, 60, 100);
+    sh101_control_note_on(&ca, 72, 100);
+    sh101_control_tick_pitch(&ca);
+    {
+        float slow_alpha = ca.glide_alpha;
+        ca.glide_ms = 5.0f;
+        sh101_control_tick_pitch(&ca);
+        assert(ca.glide_alpha > slow_alpha);
+    }
+}
+
+int main(void) {
+    check_osc_block();
+    check_osc_isa_variants();
+    check_filter_block();
+    check_env_lfo_pitch_blocks();
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+
+#include "sh101_fastmath.h"
+
+static double rel_err(double approx, double ref) {
+    return fabs(approx - ref) / fabs(ref);
+}
+
+int main(void) {
+    double worst;
+
+    worst = 0.0;
+    for (int i = 0; i <= 200000; ++i) {
+        float x = -126.0f + 252.0f * (float)i / 200000.0f;
+        double e = rel_err(sh101_fast_exp2f(x), exp2((double)x));
+        if (e > worst) worst = e;
+    }
+    printf("exp2 max rel err %.3g\n", worst);
+    assert(worst < 3e-7);
+
+    worst = 0.0;
+    for (int i = 0; i <= 200000; ++i) {
+        float x = -87.0f + 174.0f * (float)i / 200000.0f;
+        double e = rel_err(sh101_fast_expf(x), exp((double)x));
+        if (e > worst) worst = e;
+    }
+    printf("exp max rel err %.3g\n", worst);
+    assert(worst < 5e-6);
+
+    worst = 0.0;
+    for (int i = 0; i <= 200000; ++i) {
+        float x = powf(2.0f, -60.0f + 120.0f * (float)i / 200000.0f);
+        double e = fabs(sh101_fast_log2f(x) - log2((double)x));
+        if (e > worst) worst = e;
+    }
+    printf("log2 max abs err %.3g\n", worst);
+    assert(worst < 3e-7);
+
+    worst = 0.0;
+    for (int i = 0; i <= 2000; ++i) {
+        float b = 0.01f + 3.0f * (float)i / 2000.0f;
+        for (int j = 0; j <= 40; ++j) {
+            float ex = -8.0f + 16.0f * (float)j / 40.0f;
+            double ref = pow((double)b, (double)ex);
+            double e = rel_err(sh101_fast_powf(b, ex), ref) / (1.0 + fabs((double)ex * log2((double)b)));
+            if (e > worst) worst = e;
+        }
+    }
+    printf("pow max scaled rel err %.3g\n", worst);
+    assert(worst < 1e-6);
+
+    worst = 0.0;
+    for (int i = 0; i <= 200000; ++i) {
+        float x = -20.0f + 40.0f * (float)i / 200000.0f;
+        double e = fabs(sh101_fast_tanhf(x) - tanh((double)x));
+        if (e > worst) worst = e;
+    }
+    printf("tanh max abs err %.3g\n", worst);
+    assert(worst < 5e-7);
+
+    worst = 0.0;
+    for (int i = 0; i <= 200000; ++i) {
+        float p = -64.0f + 128.0f * (float)i / 200000.0f;
+        double e = fabs(sh101_fast_sin2pif(p) - sin(6.283185307179586 * (double)p));
+        if (e > worst) worst = e;
+    }
+    printf("sin2pi max abs err %.3g\n", worst);
+    assert(worst < 2e-6);
+
+    /* Block (SIMD where available) kernels agree with the scalar versions. */
+    {
+        float in[37];
+        float out[37];
+        for (int i = 0; i < 37; ++i) in[i] = -3.0f + 0.17f * (float)i;
+        sh101_fast_tanhf_block(in, out, 1.4f, 37);
+        for (int i = 0; i < 37; ++i) assert(fabsf(out[i] - sh101_fast_tanhf(1.4f * in[i])) < 1e-6f);
+        sh101_fast_sin2pif_block(in, out, 37);
+        for (int i = 0; i < 37; ++i) assert(fabsf(out[i] - sh101_fast_sin2pif(in[i])) < 1e-6f);
+        sh101_fast_exp2f_block(in, out, 37);
+        for (int i = 0; i < 37; ++i) assert(fabsf(out[i] - sh101_fast_exp2f(in[i])) <= 1e-6f * out[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "sh101_oversample.h"
+
+#define FRAMES 4096
+#define SR 44100.0
+
+static double tone_power(const float *x, int n, double hz, double sr) {
+    double w = 2.0 * 3.141592653589793 * hz / sr;
+    double c = 2.0 * cos(w);
+    double s1 = 0.0;
+    double s2 = 0.0;
+    for (int i = 0; i < n; ++i) {
+        double s0 = (double)x[i] + c * s1 - s2;
+        s2 = s1;
+        s1 = s0;
+    }
+    return s1 * s1 + s2 * s2 - c * s1 * s2;
+}
+
+/* Up then down at `factor`: in-band tones come back at unity gain. */
+static void test_passband(int factor) {
+    static const double tones[] = {100.0, 1000.0, 10000.0, 17000.0};
+    static float in[FRAMES];
+    static float hi[FRAMES * SH101_OS_MAX_FACTOR];
+    static float out[FRAMES];
+    for (int t = 0; t < 4; ++t) {
+        sh101_oversampler_t os;
+        double db;
+        sh101_oversampler_init(&os, factor);
+        for (int i = 0; i < FRAMES; ++i) in[i] = (float)sin(2.0 * 3.141592653589793 * tones[t] * i / SR);
+        sh101_oversampler_up(&os, in, hi, FRAMES);
+        sh101_oversampler_down(&os, hi, out, FRAMES);
+        /* Skip the FIR warm-up on both sides. */
+        db = 10.0 * log10(tone_power(out + 1024, FRAMES - 1024, tones[t], SR) /
+                          tone_power(in + 1024, FRAMES - 1024, tones[t], SR));
+        printf("%dx %5.0f Hz: %+.4f dB\n", factor, tones[t], db);
+        assert(fabs(db) < 0.05);
+    }
+}
+
+/* A tone above the host Nyquist at the oversampled rate must not fold
+   back into the audio band on decimation. */
+static void test_alias_rejection(int factor, double hz) {
+    static float hi[FRAMES * SH101_OS_MAX_FACTOR];
+    static float out[FRAMES];
+    sh101_oversampler_t os;
+    double folded = fmod(hz, SR);
+    double rej;
+    if (folded > SR * 0.5) folded = SR - folded;
+    sh101_oversampler_init(&os, factor);
+    for (int i = 0; i < FRAMES * factor; ++i) {
+        hi[i] = (float)sin(2.0 * 3.141592653589793 * hz * i / (SR * factor));
+    }
+    sh101_oversampler_down(&os, hi, out, FRAMES);
+    rej = 10.0 * log10(tone_power(out + 256, FRAMES - 256, folded, SR) /
+                       (0.25 * (FRAMES - 256) * (FRAMES - 256)));
+    printf("%dx %5.0f Hz -> %5.0f Hz: %.1f dB\n", factor, hz, folded, rej);
+    assert(rej < -60.0);
+}
+
+/* Chunking must not change the result. */
+static void test_block_invariance(int factor) {
+    static float in[FRAMES];
+    static float hi_a[FRAMES * SH101_OS_MAX_FACTOR];
+    static float hi_b[FRAMES * SH101_OS_MAX_FACTOR];
+    static float out_a[FRAMES];
+    static float out_b[FRAMES];
+    sh101_oversampler_t a;
+    sh101_oversampler_t b;
+    uint32_t seed = 5u;
+    for (int i = 0; i < FRAMES; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        in[i] = (float)(seed >> 9) * (2.0f / 8388608.0f) - 1.0f;
+    }
+    sh101_oversampler_init(&a, factor);
+    sh101_oversampler_init(&b, factor);
+    sh101_oversampler_up(&a, in, hi_a, FRAMES);
+    sh101_oversampler_down(&a, hi_a, out_a, FRAMES);
+    for (int done = 0; done < FRAMES; ) {
+        int n = FRAMES - done < 7 ? FRAMES - done : 7;
+        sh101_oversampler_up(&b, in + done, hi_b + done * factor, n);
+        sh101_oversampler_down(&b, hi_b + done * factor, out_b + done, n);
+        done += n;
+    }
+    assert(memcmp(hi_a, hi_b, sizeof(float) * FRAMES * factor) == 0);
+    assert(memcmp(out_a, out_b, sizeof(out_a)) == 0);
+}
+
+int main(void) {
+    test_passband(2);
+    test_passband(4);
+    test_alias_rejection(2, 30000.0);
+    test_alias_rejection(2, 40000.0);
+    test_alias_rejection(4, 60000.0);
+    test_alias_rejection(4, 30000.0);
+    test_block_invariance(2);
+    test_block_invariance(4);
+    printf("ok\n");
+    return 0;
+}
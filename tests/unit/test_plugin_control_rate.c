@@ -0,0 +1,110 @@
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host/plugin_api_v1.h"
+#include "sh101_env.h"
+
+extern plugin_api_v2_t* move_plugin_init_v2(const host_api_v1_t *host);
+
+typedef struct {
+    float rms;
+    float onset_step;
+} render_stats_t;
+
+static render_stats_t render_stats(plugin_api_v2_t *api, const char *control_rate) {
+    void *inst = api->create_instance(".", NULL);
+    int16_t out[128 * 2];
+    uint8_t on[3] = {0x90, 48, 100};
+    uint8_t off[3] = {0x80, 48, 0};
+    double sum_sq = 0.0;
+    int count = 0;
+    float prev = 0.0f;
+    render_stats_t st = {0.0f, 0.0f};
+
+    assert(inst != NULL);
+    api->set_param(inst, "preset", "1");
+    api->set_param(inst, "control_rate", control_rate);
+
+    api->on_midi(inst, on, 3, MOVE_MIDI_SOURCE_INTERNAL);
+    for (int b = 0; b < 40; ++b) {
+        api->render_block(inst, out, 128);
+        for (int i = 0; i < 128; ++i) {
+            float v = (float)out[i * 2] / 32768.0f;
+            if (b == 0 && i < 16 && fabsf(v - prev) > st.onset_step) st.onset_step = fabsf(v - prev);
+            prev = v;
+            if (b >= 8) {
+                sum_sq += (double)v * (double)v;
+                count += 1;
+            }
+        }
+    }
+    api->on_midi(inst, off, 3, MOVE_MIDI_SOURCE_INTERNAL);
+    api->render_block(inst, out, 128);
+    api->destroy_instance(inst);
+
+    st.rms = (float)sqrt(sum_sq / (double)count);
+    return st;
+}
+
+static void check_env_advance_matches_process(void) {
+    sh101_env_t a;
+    sh101_env_t b;
+    sh101_env_init(&a, 44100.0f);
+    sh101_env_init(&b, 44100.0f);
+    sh101_env_set_adsr(&a, 0.004f, 0.08f, 0.4f, 0.1f);
+    sh101_env_set_adsr(&b, 0.004f, 0.08f, 0.4f, 0.1f);
+    sh101_env_gate_on(&a, 1.0f);
+    sh101_env_gate_on(&b, 1.0f);
+    for (int t = 0; t < 1500; ++t) {
+        if (t == 300) {
+            sh101_env_gate_off(&a);
+            sh101_env_gate_off(&b);
+        }
+        for (int i = 0; i < 16; ++i) sh101_env_process(&a);
+        sh101_env_advance(&b, 16);
+        assert(fabsf(a.value - b.value) < 0.002f);
+    }
+    assert(b.stage == ENV_IDLE);
+}
+
+int main(void) {
+    host_api_v1_t host;
+    memset(&host, 0, sizeof(host));
+    host.api_version = MOVE_PLUGIN_API_VERSION;
+    host.sample_rate = 44100;
+    host.frames_per_block = 128;
+
+    plugin_api_v2_t *api = move_plugin_init_v2(&host);
+    assert(api != NULL);
+
+    check_env_advance_matches_process();
+
+    {
+        void *inst = api->create_instance(".", NULL);
+        char buf[32];
+        api->set_param(inst, "control_rate", "64");
+        assert(api->get_param(inst, "control_rate", buf, (int)sizeof(buf)) > 0);
+        assert(atoi(buf) == 32);
+        api->destroy_instance(inst);
+    }
+
+    {
+        render_stats_t ref = render_stats(api, "1");
+        render_stats_t fast = render_stats(api, "16");
+        render_stats_t slow = render_stats(api, "32");
+
+        /* Control-rate modulation must not change the level of the voice. */
+        assert(fabsf(fast.rms - ref.rms) < ref.rms * 0.03f);
+        assert(fabsf(slow.rms - ref.rms) < ref.rms * 0.03f);
+
+        /* Interpolated envelopes keep the attack as smooth as per-sample evaluation. */
+        assert(fast.onset_step <= ref.onset_step * 1.5f + 0.01f);
+        assert(slow.onset_step <= ref.onset_step * 1.5f + 0.01f);
+    }
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "host/plugin_api_v1.h"
+#include "sh101_cpu.h"
+#include "sh101_fastmath.h"
+#include "sh101_filter.h"
+
+extern plugin_api_v2_t* move_plugin_init_v2(const host_api_v1_t *host);
+
+#define BLOCK 128
+#define SOUND_BLOCKS 220
+#define TAIL_BLOCKS 1200
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* FTZ is on inside the bracket and the caller's mode comes back after. */
+static void check_ftz_bracket(void) {
+    volatile float tiny = 1e-30f;
+    volatile float scale = 1e-10f;
+    uint64_t saved = sh101_cpu_ftz_enter();
+#if defined(SH101_FASTMATH_SSE2) || defined(__aarch64__)
+    assert(tiny * scale == 0.0f);
+#endif
+    sh101_cpu_ftz_leave(saved);
+    assert(tiny * scale != 0.0f);
+}
+
+static void check_filter_flush(void) {
+    sh101_filter_t f;
+    sh101_filter_init(&f, 44100.0f);
+    f.y1 = 1e-20f;
+    f.y2 = -1e-38f;
+    f.y3 = 0.25f;
+    f.stage_prev[1] = 1e-16f;
+    sh101_filter_flush_denormals(&f);
+    assert(f.y1 == 0.0f && f.y2 == 0.0f && f.stage_prev[1] == 0.0f);
+    assert(f.y3 == 0.25f);
+}
+
+/* A voice whose oscillators are muted at note-off leaves the filter, DC
+   blocker and envelopes decaying toward zero for seconds.  Reports what
+   blocks in that tail cost next to blocks of the sounding note; subnormal
+   arithmetic would make the tail 10x or more dearer.  Report only: the
+   FTZ and flush checks above are the deterministic tests. */
+static void report_release_tail_timing(plugin_api_v2_t *api) {
+    static double cost[SOUND_BLOCKS + TAIL_BLOCKS];
+    void *inst = api->create_instance(".", NULL);
+    int16_t out[BLOCK * 2];
+    uint8_t on[3] = {0x90, 45, 110};
+    uint8_t off[3] = {0x80, 45, 0};
+    double sound = 0.0;
+    double tail = 0.0;
+
+    assert(inst != NULL);
+    api->set_param(inst, "preset", "1");
+    api->set_param(inst, "release", "8");
+    api->set_param(inst, "f_release", "8");
+    api->on_midi(inst, on, 3, MOVE_MIDI_SOURCE_INTERNAL);
+    for (int b = 0; b < SOUND_BLOCKS; ++b) {
+        double t0 = now_s();
+        api->render_block(inst, out, BLOCK);
+        cost[b] = now_s() - t0;
+    }
+    api->on_midi(inst, off, 3, MOVE_MIDI_SOURCE_INTERNAL);
+    api->set_param(inst, "saw", "0");
+    api->set_param(inst, "pulse", "0");
+    api->set_param(inst, "sub", "0");
+    api->set_param(inst, "noise", "0");
+
+    for (int b = SOUND_BLOCKS; b < SOUND_BLOCKS + TAIL_BLOCKS; ++b) {
+        double t0 = now_s();
+        api->render_block(inst, out, BLOCK);
+        cost[b] = now_s() - t0;
+    }
+    for (int b = 20; b < SOUND_BLOCKS; ++b) sound += cost[b];
+    for (int b = SOUND_BLOCKS + TAIL_BLOCKS - 200; b < SOUND_BLOCKS + TAIL_BLOCKS; ++b) tail += cost[b];
+    sound /= (double)(SOUND_BLOCKS - 20);
+    tail /= 200.0;
+    printf("sounding %.2f us/block, tail %.2f us/block\n", sound * 1e6, tail * 1e6);
+    api->destroy_instance(inst);
+}
+
+int main(void) {
+    host_api_v1_t host;
+    memset(&host, 0, sizeof(host));
+    host.api_version = MOVE_PLUGIN_API_VERSION;
+    host.sample_rate = 44100;
+    host.frames_per_block = BLOCK;
+
+    plugin_api_v2_t *api = move_plugin_init_v2(&host);
+    assert(api != NULL);
+
+    check_ftz_bracket();
+    check_filter_flush();
+    report_release_tail_timing(api);
+    printf("ok\n");
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host/plugin_api_v1.h"
+
+extern plugin_api_v2_t* move_plugin_init_v2(const host_api_v1_t *host);
+
+#define BLOCK 128
+
+static float fparam(plugin_api_v2_t *api, void *inst, const char *key) {
+    char buf[64];
+    assert(api->get_param(inst, key, buf, (int)sizeof(buf)) > 0);
+    return strtof(buf, NULL);
+}
+
+static int peak(plugin_api_v2_t *api, void *inst, int blocks) {
+    int16_t out[BLOCK * 2];
+    int p = 0;
+    for (int b = 0; b < blocks; ++b) {
+        api->render_block(inst, out, BLOCK);
+        for (int i = 0; i < BLOCK * 2; ++i) {
+            int v = abs(out[i]);
+            if (v > p) p = v;
+        }
+    }
+    return p;
+}
+
+int main(void) {
+    host_api_v1_t host;
+    memset(&host, 0, sizeof(host));
+    host.api_version = MOVE_PLUGIN_API_VERSION;
+    host.sample_rate = 44100;
+    host.frames_per_block = BLOCK;
+
+    plugin_api_v2_t *api = move_plugin_init_v2(&host);
+    void *inst = api->create_instance(".", NULL);
+    uint8_t on_soft[3] = {0x90, 48, 20};
+    uint8_t off[3] = {0x80, 48, 0};
+    assert(inst != NULL);
+
+    /* Derived values are visible to get_param straight after set_param,
+       whatever order the inputs arrived in. */
+    api->set_param(inst, "lfo_rate", "5.1");
+    api->set_param(inst, "lfo_sync", "Sync");
+    assert(fabsf(fparam(api, inst, "lfo_rate") - 5.3333333f) < 1e-4f);
+    api->set_param(inst, "velocity_mode", "Off");
+    assert(fparam(api, inst, "active_velocity") == 1.0f);
+
+    /* A velocity-sensitivity change reaches the next note's level. */
+    api->set_param(inst, "preset", "1");
+    api->set_param(inst, "velocity_mode", "Trigger");
+    api->set_param(inst, "velocity_sens", "1");
+    api->on_midi(inst, on_soft, 3, MOVE_MIDI_SOURCE_INTERNAL);
+    int soft = peak(api, inst, 40);
+    api->on_midi(inst, off, 3, MOVE_MIDI_SOURCE_INTERNAL);
+    peak(api, inst, 400);
+    api->set_param(inst, "velocity_sens", "0.3");
+    api->set_param(inst, "velocity_sens", "0");
+    api->on_midi(inst, on_soft, 3, MOVE_MIDI_SOURCE_INTERNAL);
+    int flat = peak(api, inst, 40);
+    printf("soft %d flat %d\n", soft, flat);
+    assert(flat > soft * 3 / 2);
+
+    /* A burst of changes renders exactly like setting the final values
+       once: only the last inputs reach the rebuilt values. */
+    {
+        static const char *const keys[] = {"lfo_pitch", "lfo_pwm", "glide", "key_follow", "lfo_rate", "velocity_sens"};
+        static const char *const early[] = {"0.9", "0.1", "40", "0", "12", "0.2"};
+        static const char *const last[] = {"0.4", "0.3", "120", "1", "6.5", "0.9"};
+        void *burst = api->create_instance(".", NULL);
+        void *once = api->create_instance(".", NULL);
+        int16_t a[BLOCK * 2];
+        int16_t b[BLOCK * 2];
+        uint8_t on[3] = {0x90, 55, 100};
+        uint8_t on2[3] = {0x90, 62, 70};
+        uint8_t wheel[3] = {0xB0, 1, 90};
+
+        for (int k = 0; k < 6; ++k) {
+            api->set_param(burst, keys[k], early[k]);
+            api->set_param(burst, keys[k], last[k]);
+            api->set_param(once, keys[k], last[k]);
+        }
+        api->set_param(burst, "velocity_mode", "Trigger");
+        api->set_param(once, "velocity_mode", "Trigger");
+        for (int k = 0; k < 2; ++k) {
+            void *v = k ? once : burst;
+            api->on_midi(v, wheel, 3, MOVE_MIDI_SOURCE_INTERNAL);
+            api->on_midi(v, on, 3, MOVE_MIDI_SOURCE_INTERNAL);
+        }
+        for (int blk = 0; blk < 60; ++blk) {
+            if (blk == 30) {
+                api->on_midi(burst, on2, 3, MOVE_MIDI_SOURCE_INTERNAL);
+                api->on_midi(once, on2, 3, MOVE_MIDI_SOURCE_INTERNAL);
+            }
+            api->render_block(burst, a, BLOCK);
+            api->render_block(once, b, BLOCK);
+            assert(memcmp(a, b, sizeof(a)) == 0);
+        }
+        api->destroy_instance(burst);
+        api->destroy_instance(once);
+    }
+
+    api->destroy_instance(inst);
+    printf("ok\n");
+    return 0;
+}
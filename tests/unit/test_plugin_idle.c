@@ -0,0 +1,78 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host/plugin_api_v1.h"
+
+extern plugin_api_v2_t* move_plugin_init_v2(const host_api_v1_t *host);
+
+#define BLOCK 128
+
+static int get_idle(plugin_api_v2_t *api, void *inst) {
+    char buf[16];
+    assert(api->get_param(inst, "idle", buf, (int)sizeof(buf)) > 0);
+    return atoi(buf);
+}
+
+static int peak(const int16_t *out, int frames) {
+    int p = 0;
+    for (int i = 0; i < frames * 2; ++i) {
+        int v = abs(out[i]);
+        if (v > p) p = v;
+    }
+    return p;
+}
+
+int main(void) {
+    host_api_v1_t host;
+    memset(&host, 0, sizeof(host));
+    host.api_version = MOVE_PLUGIN_API_VERSION;
+    host.sample_rate = 44100;
+    host.frames_per_block = BLOCK;
+
+    plugin_api_v2_t *api = move_plugin_init_v2(&host);
+    assert(api != NULL);
+
+    void *inst = api->create_instance(".", NULL);
+    int16_t out[BLOCK * 2];
+    uint8_t on[3] = {0x90, 48, 100};
+    uint8_t off[3] = {0x80, 48, 0};
+    int blocks;
+
+    assert(inst != NULL);
+    api->set_param(inst, "preset", "1");
+    api->set_param(inst, "sustain", "0");
+
+    /* A held key never idles, even once the envelope has decayed. */
+    api->on_midi(inst, on, 3, MOVE_MIDI_SOURCE_INTERNAL);
+    for (int b = 0; b < 1000; ++b) {
+        api->render_block(inst, out, BLOCK);
+        assert(get_idle(api, inst) == 0);
+    }
+
+    /* After the release the voice idles within a second and stays silent. */
+    api->on_midi(inst, off, 3, MOVE_MIDI_SOURCE_INTERNAL);
+    for (blocks = 0; blocks < 2000 && !get_idle(api, inst); ++blocks) {
+        api->render_block(inst, out, BLOCK);
+    }
+    printf("idle after %d blocks\n", blocks);
+    assert(get_idle(api, inst) == 1);
+    for (int b = 0; b < 50; ++b) {
+        memset(out, 0x55, sizeof(out));
+        api->render_block(inst, out, BLOCK);
+        assert(peak(out, BLOCK) == 0);
+        assert(get_idle(api, inst) == 1);
+    }
+
+    /* The next note-on leaves idle in the very next block and sounds. */
+    api->on_midi(inst, on, 3, MOVE_MIDI_SOURCE_INTERNAL);
+    api->render_block(inst, out, BLOCK);
+    assert(get_idle(api, inst) == 0);
+    assert(peak(out, BLOCK) > 100);
+
+    api->destroy_instance(inst);
+    printf("ok\n");
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "host/plugin_api_v1.h"
+#include "sh101_fastmath.h"
+
+extern plugin_api_v2_t* move_plugin_init_v2(const host_api_v1_t *host);
+
+#define BLOCK 128
+#define BLOCKS 40
+
+/* The vector conversion matches the scalar one at every length, out of
+   range input included, and mixing saturates instead of wrapping. */
+static void check_conversion(void) {
+    float in[61];
+    int16_t out[61 * 2];
+    int16_t mix[61 * 2];
+
+    for (int i = 0; i < 61; ++i) in[i] = (float)(i - 30) * 0.047f;
+    in[3] = 1.0f;
+    in[4] = -1.0f;
+    for (int n = 0; n <= 61; ++n) {
+        for (int i = 0; i < 61 * 2; ++i) out[i] = mix[i] = (int16_t)(i * 431 - 26000);
+        sh101_s16_stereo_block(in, out, n, 0);
+        sh101_s16_stereo_block(in, mix, n, 1);
+        for (int i = 0; i < n; ++i) {
+            int16_t s = sh101_s16_from_float(in[i]);
+            int32_t l = (int32_t)(i * 2 * 431 - 26000) + s;
+            int32_t r = (int32_t)((i * 2 + 1) * 431 - 26000) + s;
+            assert(out[i * 2] == s && out[i * 2 + 1] == s);
+            assert(mix[i * 2] == (l > 32767 ? 32767 : (l < -32768 ? -32768 : l)));
+            assert(mix[i * 2 + 1] == (r > 32767 ? 32767 : (r < -32768 ? -32768 : r)));
+        }
+        for (int i = n * 2; i < 61 * 2; ++i) {
+            assert(out[i] == (int16_t)(i * 431 - 26000));
+        }
+    }
+    assert(sh101_s16_from_float(1.0f) == 32767 && sh101_s16_from_float(-3.0f) == -32767);
+}
+
+static void *make_voice(plugin_api_v2_t *api, const char *mode) {
+    uint8_t on[3] = {0x90, 45, 110};
+    void *inst = api->create_instance(".", NULL);
+    assert(inst != NULL);
+    api->set_param(inst, "preset", "3");
+    api->set_param(inst, "output_mode", mode);
+    api->on_midi(inst, on, 3, MOVE_MIDI_SOURCE_INTERNAL);
+    return inst;
+}
+
+int main(void) {
+    static int16_t ref[BLOCKS][BLOCK * 2];
+    static uint8_t mapped[64 + BLOCK * 4];
+    host_api_v1_t host;
+    int16_t out[BLOCK * 2];
+    char buf[16];
+
+    check_conversion();
+
+    memset(&host, 0, sizeof(host));
+    host.api_version = MOVE_PLUGIN_API_VERSION;
+    host.sample_rate = 44100;
+    host.frames_per_block = BLOCK;
+    host.mapped_memory = mapped;
+    host.audio_out_offset = 64;
+
+    plugin_api_v2_t *api = move_plugin_init_v2(&host);
+    assert(api != NULL);
+
+    void *a = make_voice(api, "Replace");
+    void *b = make_voice(api, "Mix");
+    void *c = make_voice(api, "Mix");
+    void *d = make_voice(api, "Replace");
+    assert(api->get_param(b, "output_mode", buf, (int)sizeof(buf)) > 0);
+    assert(strcmp(buf, "Mix") == 0);
+    assert(api->get_param(c, "output_target", buf, (int)sizeof(buf)) > 0);
+    assert(strcmp(buf, "Buffer") == 0);
+    api->set_param(c, "output_target", "Host Output");
+    assert(api->get_param(c, "output_target", buf, (int)sizeof(buf)) > 0);
+    assert(strcmp(buf, "Host Output") == 0);
+
+    for (int k = 0; k < BLOCKS; ++k) {
+        /* Replace overwrites whatever the host left in the buffer. */
+        memset(ref[k], 0x55, sizeof(ref[k]));
+        api->render_block(a, ref[k], BLOCK);
+
+        /* Mix adds onto an existing signal with saturation. */
+        for (int i = 0; i < BLOCK * 2; ++i) out[i] = (int16_t)(i & 1 ? -20000 : 20000);
+        api->render_block(b, out, BLOCK);
+        for (int i = 0; i < BLOCK * 2; ++i) {
+            int32_t v = (int32_t)ref[k][i] + (i & 1 ? -20000 : 20000);
+            assert(out[i] == (v > 32767 ? 32767 : (v < -32768 ? -32768 : v)));
+        }
+
+        /* "Host Output" renders straight into the host's mapped output,
+           whatever buffer is passed. */
+        memset(mapped + 64, 0, BLOCK * 4);
+        api->render_block(c, k & 1 ? NULL : out, BLOCK);
+        assert(memcmp(mapped + 64, ref[k], BLOCK * 4) == 0);
+
+        /* The default target never touches the mapped output, and a NULL
+           buffer renders nothing. */
+        api->render_block(d, NULL, BLOCK);
+        memset(out, 0x55, sizeof(out));
+        api->render_block(d, out, BLOCK);
+        assert(memcmp(mapped + 64, ref[k], BLOCK * 4) == 0);
+    }
+    for (int i = 0; i < 64; ++i) assert(mapped[i] == 0);
+
+    api->destroy_instance(a);
+    api->destroy_instance(b);
+    api->destroy_instance(c);
+    api->destroy_instance(d);
+    printf("ok\n");
+    return 0;
+}
@@ -0,0 +1,307 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "host/plugin_api_v1.h"
+#include "sh101_poly.h"
+
+extern plugin_api_v2_t* move_plugin_init_v2(const host_api_v1_t *host);
+
+#define BLOCK 128
+
+static void expect(plugin_api_v2_t *api, void *inst, const char *key, const char *want) {
+    char buf[32];
+    assert(api->get_param(inst, key, buf, (int)sizeof(buf)) > 0);
+    assert(strcmp(buf, want) == 0);
+}
+
+static void send(plugin_api_v2_t *api, void *inst, int status, int note, int vel) {
+    uint8_t msg[3] = {(uint8_t)status, (uint8_t)note, (uint8_t)vel};
+    api->on_midi(inst, msg, 3, MOVE_MIDI_SOURCE_INTERNAL);
+}
+
+static int peak(const int16_t *out, int frames) {
+    int m = 0;
+    for (int i = 0; i < frames * 2; ++i) {
+        int a = abs(out[i]);
+        if (a > m) m = a;
+    }
+    return m;
+}
+
+/* Allocation order and stealing, on the pool alone. */
+static void check_pool(void) {
+    static sh101_poly_t p;
+    sh101_poly_init(&p, 44100.0f);
+
+    assert(sh101_poly_note_on(&p, 4, 60) == 0);
+    assert(sh101_poly_note_on(&p, 4, 64) == 1);
+    assert(sh101_poly_note_on(&p, 4, 67) == 2);
+    /* The same note reuses its voice. */
+    assert(sh101_poly_note_on(&p, 4, 64) == 1);
+    assert(sh101_poly_note_on(&p, 4, 71) == 3);
+
+    /* All held: the oldest is stolen. */
+    assert(sh101_poly_note_on(&p, 4, 72) == 0);
+
+    /* A released voice goes before any held one. */
+    assert(sh101_poly_note_off(&p, 4, 67) == 2);
+    assert(sh101_poly_note_off(&p, 4, 67) == -1);
+    assert(sh101_poly_note_on(&p, 4, 74) == 2);
+
+    /* Voices past the count in use are never picked. */
+    sh101_poly_reset(&p);
+    assert(sh101_poly_note_on(&p, 2, 60) == 0);
+    assert(sh101_poly_note_on(&p, 2, 62) == 1);
+    assert(sh101_poly_note_on(&p, 2, 64) == 0);
+    for (int v = 2; v < SH101_POLY_MAX_VOICES; ++v) assert(!sh101_poly_voice_active(&p, v));
+}
+
+/* Largest sample-to-sample step of one voice playing a bare /2 sub. */
+static float sub_edge(int band_limited, int adaa) {
+    static sh101_poly_t p;
+    static float out[2048];
+    sh101_poly_patch_t patch;
+    float step = 0.0f;
+
+    memset(&patch, 0, sizeof(patch));
+    patch.sub_mix = 1.0f;
+    patch.sub_mode = 0;
+    patch.band_limited = band_limited;
+    patch.adaa = adaa;
+    patch.makeup_gain = 1.0f;
+
+    sh101_poly_init(&p, 44100.0f);
+    sh101_poly_note_on(&p, 4, 60);
+    p.inc[0] = p.inc_to[0] = 0.0137f;
+    p.g[0] = p.g_to[0] = 0.5f;
+    p.bypass[0] = p.bypass_to[0] = 1.0f;
+    p.vca[0] = p.vca_to[0] = 1.0f;
+    memset(out, 0, sizeof(out));
+    sh101_poly_render(&p, &patch, 4, out, 2048);
+    for (int i = 1; i < 2048; ++i) {
+        float d = fabsf(out[i] - out[i - 1]);
+        assert(out[i] == out[i]);
+        if (d > step) step = d;
+    }
+    return step;
+}
+
+static void write_poly_fixture(const char *path) {
+    static const char xml[] =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?> "
+        "<tal curprogram=\"0\" version=\"2.0\">"
+        "<programs><program programname=\"Poly\" sawvolume=\"1.0\" polymode=\"1.0\"/>"
+        "</programs></tal>";
+    FILE *fp = fopen(path, "wb");
+    assert(fp != NULL);
+    fwrite("VST3\0\0", 1, 6, fp);
+    fwrite(xml, 1, sizeof(xml) - 1, fp);
+    fwrite("\0tail", 1, 5, fp);
+    fclose(fp);
+}
+
+/* A lane group with no active voice is skipped: its state is left as it
+   was, even with a pitch set. */
+static void check_idle_groups(void) {
+    static sh101_poly_t p;
+    static float out[256];
+    sh101_poly_patch_t patch;
+
+    memset(&patch, 0, sizeof(patch));
+    patch.saw_mix = 1.0f;
+    patch.makeup_gain = 1.0f;
+    sh101_poly_init(&p, 44100.0f);
+    assert(sh101_poly_note_on(&p, 8, 60) == 0);
+    for (int v = 0; v < SH101_POLY_MAX_VOICES; ++v) {
+        p.inc[v] = p.inc_to[v] = 0.01f;
+        p.g[v] = p.g_to[v] = 0.5f;
+    }
+    p.vca[0] = p.vca_to[0] = 1.0f;
+    sh101_poly_render(&p, &patch, 8, out, 256);
+    assert(p.acc[0] != 0.0f);
+    for (int v = SH101_POLY_LANES; v < SH101_POLY_MAX_VOICES; ++v) {
+        assert(p.acc[v] == 0.0f);
+        assert(p.y1[v] == 0.0f);
+    }
+}
+
+/* Rising zero crossings of the left channel over blocks 100-399 (~0.87 s). */
+static float tone_hz(const int16_t *tone) {
+    int first = 100 * BLOCK;
+    int frames = 300 * BLOCK;
+    int crossings = 0;
+    for (int i = first + 1; i < first + frames; ++i) {
+        if (tone[(i - 1) * 2] < 0 && tone[i * 2] >= 0) ++crossings;
+    }
+    return (float)crossings * 44100.0f / (float)frames;
+}
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Render time of `notes` held keys over `blocks` blocks. */
+static double time_notes(plugin_api_v2_t *api, const char *polymode, int notes, int blocks) {
+    static int16_t out[BLOCK * 2];
+    void *inst = api->create_instance(".", NULL);
+    assert(inst != NULL);
+    api->set_param(inst, "polymode", polymode);
+    api->set_param(inst, "sustain", "1");
+    for (int k = 0; k < notes; ++k) send(api, inst, 0x90, 48 + k * 4, 100);
+    double t0 = now_s();
+    for (int b = 0; b < blocks; ++b) api->render_block(inst, out, BLOCK);
+    double t = now_s() - t0;
+    api->destroy_instance(inst);
+    return t;
+}
+
+int main(void) {
+    static int16_t out[BLOCK * 2];
+    static int16_t tone[400 * BLOCK * 2];
+    host_api_v1_t host;
+
+    check_pool();
+    check_idle_groups();
+
+    /* Band limiting spreads each sub edge over two samples; so does ADAA
+       on the mixer clip, on its own. */
+    assert(sub_edge(1, 0) < 0.75f * sub_edge(0, 0));
+    assert(sub_edge(0, 1) < 0.75f * sub_edge(0, 0));
+
+    memset(&host, 0, sizeof(host));
+    host.api_version = MOVE_PLUGIN_API_VERSION;
+    host.sample_rate = 44100;
+    host.frames_per_block = BLOCK;
+
+    plugin_api_v2_t *api = move_plugin_init_v2(&host);
+    void *inst = api->create_instance(".", NULL);
+    assert(inst != NULL);
+
+    expect(api, inst, "polymode", "Off");
+    expect(api, inst, "poly_voices", "4");
+    api->set_param(inst, "poly_voices", "12");
+    expect(api, inst, "poly_voices", "8");
+    api->set_param(inst, "poly_voices", "4");
+    api->set_param(inst, "polymode", "On");
+    expect(api, inst, "polymode", "On");
+
+    /* A chord takes one voice per key; a fifth key steals. */
+    send(api, inst, 0x90, 48, 100);
+    send(api, inst, 0x90, 52, 100);
+    send(api, inst, 0x90, 55, 100);
+    send(api, inst, 0x90, 59, 100);
+    expect(api, inst, "active_voices", "4");
+    for (int b = 0; b < 20; ++b) api->render_block(inst, out, BLOCK);
+    assert(peak(out, BLOCK) > 500);
+    send(api, inst, 0x90, 62, 100);
+    expect(api, inst, "active_voices", "4");
+
+    /* Releasing every key lets the pool fall silent. */
+    send(api, inst, 0x80, 48, 0);
+    send(api, inst, 0x80, 52, 0);
+    send(api, inst, 0x80, 55, 0);
+    send(api, inst, 0x80, 59, 0);
+    send(api, inst, 0x80, 62, 0);
+    for (int b = 0; b < 2000; ++b) api->render_block(inst, out, BLOCK);
+    expect(api, inst, "active_voices", "0");
+    assert(peak(out, BLOCK) == 0);
+
+    /* A host all-notes-off stops a held chord. */
+    send(api, inst, 0x90, 48, 100);
+    send(api, inst, 0x90, 52, 100);
+    send(api, inst, 0x90, 55, 100);
+    for (int b = 0; b < 20; ++b) api->render_block(inst, out, BLOCK);
+    assert(peak(out, BLOCK) > 500);
+    api->set_param(inst, "all_notes_off", "1");
+    expect(api, inst, "active_voices", "0");
+    for (int b = 0; b < 4; ++b) api->render_block(inst, out, BLOCK);
+    assert(peak(out, BLOCK) == 0);
+
+    /* Fewer voices: those past the new count are released, not cut, and
+       the ones below it keep playing. */
+    send(api, inst, 0x90, 48, 100);
+    send(api, inst, 0x90, 52, 100);
+    send(api, inst, 0x90, 55, 100);
+    send(api, inst, 0x90, 59, 100);
+    for (int b = 0; b < 20; ++b) api->render_block(inst, out, BLOCK);
+    {
+        int before = peak(out, BLOCK);
+        api->set_param(inst, "poly_voices", "2");
+        expect(api, inst, "active_voices", "4");
+        api->render_block(inst, out, BLOCK);
+        assert(peak(out, BLOCK) > before / 2);
+    }
+    for (int b = 0; b < 2000; ++b) api->render_block(inst, out, BLOCK);
+    expect(api, inst, "active_voices", "2");
+    assert(peak(out, BLOCK) > 500);
+    api->set_param(inst, "all_notes_off", "1");
+    api->set_param(inst, "poly_voices", "4");
+
+    /* A TAL poly preset turns poly mode on; a factory preset turns it
+       back off. */
+    api->set_param(inst, "polymode", "Off");
+    write_poly_fixture("build/poly_fixture.vstpreset");
+    api->set_param(inst, "import_vstpreset_path", "build/poly_fixture.vstpreset");
+    expect(api, inst, "polymode", "On");
+    api->set_param(inst, "preset", "1");
+    expect(api, inst, "polymode", "Off");
+    api->set_param(inst, "polymode", "On");
+
+    /* Leaving poly mode silences the pool. */
+    send(api, inst, 0x90, 60, 100);
+    api->set_param(inst, "polymode", "Off");
+    expect(api, inst, "active_voices", "0");
+    api->destroy_instance(inst);
+
+    /* A bare saw on A4 plays at 440 Hz. */
+    inst = api->create_instance(".", NULL);
+    assert(inst != NULL);
+    api->set_param(inst, "polymode", "On");
+    api->set_param(inst, "saw", "1");
+    api->set_param(inst, "pulse", "0");
+    api->set_param(inst, "sub", "0");
+    api->set_param(inst, "noise", "0");
+    api->set_param(inst, "cutoff", "1");
+    api->set_param(inst, "sustain", "1");
+    api->set_param(inst, "lfo_pitch", "0");
+    send(api, inst, 0x90, 69, 127);
+    for (int b = 0; b < 400; ++b) api->render_block(inst, tone + b * BLOCK * 2, BLOCK);
+    {
+        float hz = tone_hz(tone);
+        assert(hz > 430.0f && hz < 450.0f);
+    }
+    /* Transposing retunes the held key. */
+    api->set_param(inst, "transpose", "12");
+    for (int b = 0; b < 400; ++b) api->render_block(inst, tone + b * BLOCK * 2, BLOCK);
+    {
+        float hz = tone_hz(tone);
+        assert(hz > 860.0f && hz < 900.0f);
+    }
+    api->destroy_instance(inst);
+
+    /* Benchmark only, not a check: four voices in one pool against one
+       mono voice. */
+    {
+        double mono = 1e9;
+        double poly = 1e9;
+        for (int r = 0; r < 3; ++r) {
+            double m = time_notes(api, "Off", 1, 2000);
+            double p = time_notes(api, "On", 4, 2000);
+            if (m < mono) mono = m;
+            if (p < poly) poly = p;
+        }
+        printf("4 poly voices: %.2fx one mono voice\n", poly / mono);
+    }
+
+    printf("ok\n");
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "host/plugin_api_v1.h"
+
+extern plugin_api_v2_t* move_plugin_init_v2(const host_api_v1_t *host);
+
+#define BLOCK 128
+#define BLOCKS 60
+
+static void expect(plugin_api_v2_t *api, void *inst, const char *key, const char *want) {
+    char buf[32];
+    assert(api->get_param(inst, key, buf, (int)sizeof(buf)) > 0);
+    assert(strcmp(buf, want) == 0);
+}
+
+static void render(plugin_api_v2_t *api, const char *quality, int16_t out[BLOCKS][BLOCK * 2]) {
+    uint8_t on[3] = {0x90, 40, 120};
+    void *inst = api->create_instance(".", NULL);
+    assert(inst != NULL);
+    api->set_param(inst, "preset", "5");
+    api->set_param(inst, "quality", quality);
+    api->on_midi(inst, on, 3, MOVE_MIDI_SOURCE_INTERNAL);
+    for (int k = 0; k < BLOCKS; ++k) api->render_block(inst, out[k], BLOCK);
+    api->destroy_instance(inst);
+}
+
+int main(void) {
+    static int16_t eco[BLOCKS][BLOCK * 2];
+    static int16_t normal[BLOCKS][BLOCK * 2];
+    static int16_t high[BLOCKS][BLOCK * 2];
+    host_api_v1_t host;
+    int16_t out[BLOCK * 2];
+
+    memset(&host, 0, sizeof(host));
+    host.api_version = MOVE_PLUGIN_API_VERSION;
+    host.sample_rate = 44100;
+    host.frames_per_block = BLOCK;
+
+    plugin_api_v2_t *api = move_plugin_init_v2(&host);
+    void *inst = api->create_instance(".", NULL);
+    assert(inst != NULL);
+
+    /* The tier changes what runs, not the settings the user sees. */
+    expect(api, inst, "quality", "Normal");
+    expect(api, inst, "quality_auto", "Off");
+    expect(api, inst, "osc_antialias", "Off");
+    api->set_param(inst, "oversampling", "2x");
+    api->set_param(inst, "quality", "Eco");
+    expect(api, inst, "quality", "Eco");
+    expect(api, inst, "quality_active", "Eco");
+    expect(api, inst, "oversampling", "2x");
+    api->set_param(inst, "quality", "High");
+    expect(api, inst, "quality_active", "High");
+    expect(api, inst, "osc_antialias", "Off");
+    api->destroy_instance(inst);
+
+    /* Each tier renders something different from Normal. */
+    render(api, "Eco", eco);
+    render(api, "Normal", normal);
+    render(api, "High", high);
+    assert(memcmp(eco, normal, sizeof(normal)) != 0);
+    assert(memcmp(high, normal, sizeof(normal)) != 0);
+
+    /* A host rate no block can keep up with: auto mode steps down to Eco
+       (the tier is applied before the next block, so it has to render). */
+    host.sample_rate = 48000000;
+    inst = api->create_instance(".", NULL);
+    assert(inst != NULL);
+    {
+        uint8_t on[3] = {0x90, 52, 100};
+        api->set_param(inst, "quality", "High");
+        api->set_param(inst, "quality_auto", "On");
+        api->on_midi(inst, on, 3, MOVE_MIDI_SOURCE_INTERNAL);
+        for (int k = 0; k < 40; ++k) api->render_block(inst, out, BLOCK);
+        expect(api, inst, "quality", "High");
+        expect(api, inst, "quality_active", "Eco");
+
+        /* Choosing a tier again restarts from it. */
+        api->set_param(inst, "quality", "Normal");
+        expect(api, inst, "quality_active", "Normal");
+    }
+    api->destroy_instance(inst);
+
+    printf("ok\n");
+    return 0;
+}
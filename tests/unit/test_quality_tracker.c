@@ -0,0 +1,103 @@
+#include <assert.h>
+#include <stdio.h>
+
+#include "sh101_quality.h"
+
+#define SR 44100.0f
+#define BLOCK 128
+
+/* Blocks at `load` until the active tier moves; returns the count. */
+static int blocks_until_step(sh101_quality_state_t *q, float load, int limit) {
+    for (int b = 1; b <= limit; ++b) {
+        if (sh101_quality_track(q, load, BLOCK, SR)) return b;
+    }
+    return -1;
+}
+
+/* `count` instances, each spending `share` of the deadline per block, fed
+   through one meter for `blocks` host callbacks.  Returns how many of the
+   instances left `from`. */
+static int run_instances(int count, float share, int blocks, int from) {
+    sh101_quality_meter_t m = {0};
+    sh101_quality_state_t q[4];
+    uint32_t seen[4];
+    float deadline_ns = (float)BLOCK * 1e9f / SR;
+    int moved = 0;
+
+    for (int i = 0; i < count; ++i) {
+        sh101_quality_restart(&q[i], from);
+        seen[i] = m.round - 1u;
+    }
+    for (int b = 0; b < blocks; ++b) {
+        for (int i = 0; i < count; ++i) {
+            sh101_quality_meter_add(&m, &seen[i], (uint64_t)(share * deadline_ns));
+            sh101_quality_track(&q[i], (float)m.last_ns / deadline_ns, BLOCK, SR);
+        }
+    }
+    for (int i = 0; i < count; ++i) moved += q[i].active != from;
+    return moved;
+}
+
+int main(void) {
+    sh101_quality_state_t q;
+    int calm_blocks = (int)(SH101_QUALITY_CALM_S * SR) / BLOCK;
+
+    sh101_quality_restart(&q, SH101_QUALITY_HIGH);
+    assert(q.active == SH101_QUALITY_HIGH);
+
+    /* One overrun short of the limit: the next one steps down. */
+    q.overrun_score = SH101_QUALITY_OVERRUN_BLOCKS - 1;
+    assert(sh101_quality_track(&q, 1.5f, BLOCK, SR) == 1);
+    assert(q.active == SH101_QUALITY_NORMAL);
+    assert(q.overrun_score == 0);
+
+    /* Sustained overruns reach Eco and stay there. */
+    assert(blocks_until_step(&q, 1.5f, 100) == SH101_QUALITY_OVERRUN_BLOCKS);
+    assert(q.active == SH101_QUALITY_ECO);
+    assert(blocks_until_step(&q, 1.5f, 100) == -1);
+    assert(q.active == SH101_QUALITY_ECO);
+
+    /* Loads between the thresholds hold the tier: the hysteresis band. */
+    assert(blocks_until_step(&q, 0.5f, 4 * calm_blocks) == -1);
+
+    /* Calm blocks recover one tier per CALM_S, up to the chosen tier. */
+    {
+        int b = blocks_until_step(&q, 0.1f, 4 * calm_blocks);
+        assert(b >= calm_blocks && b <= calm_blocks + 1);
+        assert(q.active == SH101_QUALITY_NORMAL);
+    }
+    assert(blocks_until_step(&q, 0.1f, 4 * calm_blocks) > 0);
+    assert(q.active == SH101_QUALITY_HIGH);
+    assert(blocks_until_step(&q, 0.1f, 4 * calm_blocks) == -1);
+
+    /* A single overrun restarts the calm count. */
+    sh101_quality_restart(&q, SH101_QUALITY_NORMAL);
+    q.active = SH101_QUALITY_ECO;
+    assert(blocks_until_step(&q, 0.1f, calm_blocks - 10) == -1);
+    assert(sh101_quality_track(&q, 1.5f, BLOCK, SR) == 0);
+    assert(blocks_until_step(&q, 0.1f, calm_blocks - 10) == -1);
+    assert(q.active == SH101_QUALITY_ECO);
+
+    /* The meter closes a round when an instance renders again, and reports
+       the whole round. */
+    {
+        sh101_quality_meter_t m = {0};
+        uint32_t a = m.round - 1u, b = m.round - 1u;
+        sh101_quality_meter_add(&m, &a, 100);
+        sh101_quality_meter_add(&m, &b, 200);
+        assert(m.last_ns == 0);
+        sh101_quality_meter_add(&m, &a, 100);
+        assert(m.last_ns == 300);
+        sh101_quality_meter_add(&m, &b, 200);
+        assert(m.spent_ns == 300);
+    }
+
+    /* Three instances at 30% each: no one of them overruns, but the
+       callback does, and all three step down. */
+    assert(run_instances(1, 0.3f, 10 * SH101_QUALITY_OVERRUN_BLOCKS, SH101_QUALITY_HIGH) == 0);
+    assert(run_instances(3, 0.3f, 2 * SH101_QUALITY_OVERRUN_BLOCKS, SH101_QUALITY_HIGH) == 3);
+    assert(run_instances(2, 0.3f, 10 * SH101_QUALITY_OVERRUN_BLOCKS, SH101_QUALITY_HIGH) == 0);
+
+    printf("ok\n");
+    return 0;
+}
@@ -85,6 +85,12 @@ def main() -> int:
             "src/dsp/sh101_env.c",
             "src/dsp/sh101_filter.c",
             "src/dsp/sh101_lfo.c",
+            "src/dsp/sh101_adaa.c",
+            "src/dsp/sh101_oversample.c",
+            "src/dsp/sh101_noise.c",
+            "src/dsp/sh101_cpu.c",
+            "src/dsp/sh101_poly.c",
+            "src/dsp/sh101_quality.c",
             "-o",
             str(measure_sh101),
             "-lm",